@@ -0,0 +1,35 @@
+#include <ilcplex/ilocplex.h>
+ILOSTLBEGIN
+
+#include "../tools/others.hpp"
+#include "benchmark.hpp"
+
+/****************************************************************************************
+ * Benchmark suite. Runs a fixed ladder of instance sizes through Data loading, Model 
+ * construction and a time-capped solve, writes the measures as JSON and, optionally, 
+ * compares them against a baseline file. Usage:
+ * 		./bench_exec output.json [baseline.json] [threshold]
+ * The program returns a non-zero code whenever a regression is flagged.
+****************************************************************************************/
+int main(int argc, char *argv[]) {
+    greetingMessage();
+    if (argc < 2 || argc > 4){
+        std::cerr << "Please run the benchmark in the following way: \n ./bench_exec output.json [baseline.json] [threshold]\n";
+        return 1;
+    }
+    std::string outputFile = argv[1];
+    std::string baselineFile = (argc > 2) ? argv[2] : "";
+    double threshold = (argc > 3) ? atof(argv[3]) : 0.10;
+
+    Benchmark benchmark("bench_instances");
+    benchmark.run();
+    benchmark.writeJson(outputFile);
+
+    if (!baselineFile.empty()){
+        int nbRegressions = benchmark.compare(baselineFile, threshold);
+        if (nbRegressions > 0){
+            return 2;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,341 @@
+#include "benchmark.hpp"
+
+#include <sys/stat.h>
+
+/****************************************************************************************/
+/*										Constructor										*/
+/****************************************************************************************/
+
+/** Constructor. **/
+Benchmark::Benchmark(const std::string &dir) : directory(dir)
+{
+	/* The ladder is fixed so that results are comparable from one run to another. */
+	ladder.push_back({"xs",  10,  3, 3, false, true});
+	ladder.push_back({"s",   25,  4, 3, false, true});
+	ladder.push_back({"m",   50,  6, 3, false, true});
+	ladder.push_back({"l",  100,  8, 3, false, true});
+	ladder.push_back({"xl", 150, 10, 3, false, true});
+	/* The same symmetric instance solved without and with symmetry breaking. */
+	ladder.push_back({"sym",       40, 6, 6, true, false});
+	ladder.push_back({"sym-break", 40, 6, 6, true, true});
+}
+
+/****************************************************************************************/
+/*										Methods											*/
+/****************************************************************************************/
+
+/* Runs every step of the ladder. */
+void Benchmark::run()
+{
+	mkdir(directory.c_str(), 0755);
+	results.clear();
+	for (unsigned int s = 0; s < ladder.size(); s++){
+		std::cout << "=> Running benchmark step '" << ladder[s].name << "' ..." << std::endl;
+		results.push_back(runStep(ladder[s]));
+	}
+}
+
+/* Writes the instance files of a ladder step and returns the path of its parameter file. */
+std::string Benchmark::writeInstance(const BenchmarkStep &step) const
+{
+	std::mt19937 generator(BENCH_SEED + step.nbRU);
+	std::uniform_real_distribution<double> throughput(5e8, 5e9);
+	std::uniform_real_distribution<double> latency(2e-6, 4e-6);
+	std::uniform_int_distribution<int> firstEC(1, step.nbEC);
+
+	std::string prefix = directory + "/" + step.name;
+
+	/* Nodes: RUs, ECs and a single RC. */
+	std::ofstream nodeFile(prefix + "_node.csv");
+	nodeFile << "name;type;cu_cost;du_cost;" << std::endl;
+	for (int r = 1; r <= step.nbRU; r++){
+		nodeFile << "RU" << r << ";RU;1000.0;1000.0;" << std::endl;
+	}
+	for (int e = 1; e <= step.nbEC; e++){
+		nodeFile << "EC" << e << ";EC;1000.0;100.0;" << std::endl;
+	}
+	nodeFile << "RC1;RC;0.0;0.0;" << std::endl;
+	nodeFile.close();
+
+	/* Links: each RU reaches a few consecutive ECs, ECs form a ring (or a full mesh) and all of them reach the RC. */
+	std::ofstream linkFile(prefix + "_link.csv");
+	linkFile << "name;source;target;link_capacity;" << std::endl;
+	for (int r = 1; r <= step.nbRU; r++){
+		int first = firstEC(generator);
+		for (int d = 0; d < step.degreeRU && d < step.nbEC; d++){
+			int e = (first - 1 + d) % step.nbEC + 1;
+			linkFile << "RU" << r << "_EC" << e << ";RU" << r << ";EC" << e << ";10000000000.0;" << std::endl;
+		}
+	}
+	for (int e = 1; e <= step.nbEC; e++){
+		int next = e % step.nbEC + 1;
+		if (step.symmetric){
+			for (int f = 1; f <= step.nbEC; f++){
+				if (f != e){
+					linkFile << "EC" << e << "_EC" << f << ";EC" << e << ";EC" << f << ";10000000000.0;" << std::endl;
+				}
+			}
+		}
+		else if (next != e){
+			linkFile << "EC" << e << "_EC" << next << ";EC" << e << ";EC" << next << ";10000000000.0;" << std::endl;
+			linkFile << "EC" << next << "_EC" << e << ";EC" << next << ";EC" << e << ";10000000000.0;" << std::endl;
+		}
+		linkFile << "EC" << e << "_RC1;EC" << e << ";RC1;1000000000000.0;" << std::endl;
+		linkFile << "RC1_EC" << e << ";RC1;EC" << e << ";10000000000.0;" << std::endl;
+	}
+	linkFile.close();
+
+	/* Demands: one per RU. */
+	std::ofstream demandFile(prefix + "_demand.csv");
+	demandFile << "name;source;max_latency;throughput;" << std::endl;
+	demandFile.precision(12);
+	for (int r = 1; r <= step.nbRU; r++){
+		demandFile << r << ";RU" << r << ";" << latency(generator) << ";" << throughput(generator) << ";" << std::endl;
+	}
+	demandFile.close();
+
+	/* Parameter file. */
+	std::string parameterFile = prefix + "_parameters.txt";
+	std::ofstream paramFile(parameterFile);
+	paramFile << "nodeFile=" << prefix << "_node.csv" << std::endl;
+	paramFile << "linkFile=" << prefix << "_link.csv" << std::endl;
+	paramFile << "demandFile=" << prefix << "_demand.csv" << std::endl;
+	paramFile << "linearRelaxation=0" << std::endl;
+	paramFile << "timeLimit=" << BENCH_TIME_LIMIT << std::endl;
+	paramFile << "symmetry=" << step.symmetryBreaking << std::endl;
+	paramFile << "outputFile=" << std::endl;
+	paramFile.close();
+
+	return parameterFile;
+}
+
+/* Runs a single ladder step and returns its measures. */
+BenchmarkResult Benchmark::runStep(const BenchmarkStep &step) const
+{
+	BenchmarkResult result;
+	result.name = step.name;
+	result.loadTime = result.buildTime = result.solveTime = 0.0;
+	result.nbColumns = result.nbRows = result.nbNonZeros = 0;
+	result.status = "Unknown";
+	result.objective = result.gap = NAN;
+
+	std::string parameterFile = writeInstance(step);
+
+	resetPeakMemory();
+	double startStep = getWallTime();
+
+	/* Data loading */
+	double start = getWallTime();
+	Data data(parameterFile);
+	if (data.getInput().isPresolve()){
+		Presolve presolve(data);
+		presolve.run();
+	}
+	result.loadTime = getWallTime() - start;
+	result.nbNodes = data.getNbNodes();
+	result.nbLinks = data.getNbLinks();
+	result.nbDemands = data.getNbDemands();
+
+	IloEnv env;
+	try
+	{
+		/* Model construction */
+		start = getWallTime();
+		Model model(env, data);
+		result.buildTime = getWallTime() - start;
+		result.buildStepNames = model.getBuildStepNames();
+		result.buildStepTimes.assign(model.getBuildStepTimes().begin(), model.getBuildStepTimes().end());
+
+		/* Solve */
+		start = getWallTime();
+		model.run();
+		result.solveTime = getWallTime() - start;
+
+		const IloCplex& cplex = model.getCplex();
+		result.nbColumns = cplex.getNcols();
+		result.nbRows = cplex.getNrows();
+		result.nbNonZeros = cplex.getNNZs();
+
+		std::ostringstream status;
+		status << cplex.getStatus();
+		result.status = status.str();
+		if (cplex.getStatus() == IloCplex::Optimal || cplex.getStatus() == IloCplex::Feasible){
+			result.objective = model.getObjValue();
+			result.gap = cplex.getMIPRelativeGap()*100;
+		}
+	}
+	catch (const IloException& e) { std::cerr << "Exception caught: " << e << std::endl; result.status = "Error"; }
+	env.end();
+
+	result.wallTime = getWallTime() - startStep;
+	result.peakMemory = getPeakMemory();
+	return result;
+}
+
+/* Writes the results as JSON. */
+void Benchmark::writeJson(const std::string &filename) const
+{
+	std::ofstream file(filename);
+	if (!file){
+		std::cerr << "ERROR: Unable to open benchmark output file '" << filename << "'." << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	file << "{" << std::endl;
+	file << "  \"timeLimit\": " << BENCH_TIME_LIMIT << "," << std::endl;
+	file << "  \"instances\": [" << std::endl;
+	/* Each instance is kept on a single line so that baselines can be compared line by line. */
+	for (unsigned int s = 0; s < results.size(); s++){
+		file << "    ";
+		writeJsonLine(file, results[s]);
+		file << (s + 1 < results.size() ? "," : "") << std::endl;
+	}
+	file << "  ]" << std::endl;
+	file << "}" << std::endl;
+	file.close();
+	std::cout << "=> Benchmark results written to " << filename << std::endl;
+}
+
+/* Writes the measures of a single step as a one-line JSON object. */
+void Benchmark::writeJsonLine(std::ostream &out, const BenchmarkResult &r) const
+{
+	out.precision(12);
+	out << "{\"name\": \"" << r.name << "\", "
+		<< "\"nodes\": " << r.nbNodes << ", "
+		<< "\"links\": " << r.nbLinks << ", "
+		<< "\"demands\": " << r.nbDemands << ", "
+		<< "\"loadTime\": " << r.loadTime << ", "
+		<< "\"buildTime\": " << r.buildTime << ", "
+		<< "\"buildSteps\": {";
+	for (unsigned int b = 0; b < r.buildStepNames.size(); b++){
+		out << (b > 0 ? ", " : "") << "\"" << r.buildStepNames[b] << "\": " << r.buildStepTimes[b];
+	}
+	out << "}, "
+		<< "\"solveTime\": " << r.solveTime << ", "
+		<< "\"wallTime\": " << r.wallTime << ", "
+		<< "\"peakMemoryKB\": " << r.peakMemory << ", "
+		<< "\"columns\": " << r.nbColumns << ", "
+		<< "\"rows\": " << r.nbRows << ", "
+		<< "\"nonzeros\": " << r.nbNonZeros << ", "
+		<< "\"status\": \"" << r.status << "\", "
+		<< "\"objective\": ";
+	if (std::isnan(r.objective)) { out << "null"; } else { out << r.objective; }
+	out << ", \"gap\": ";
+	if (std::isnan(r.gap)) { out << "null"; } else { out << r.gap; }
+	out << "}";
+}
+
+/* Compares the results against a baseline JSON file and returns the number of regressions found. */
+int Benchmark::compare(const std::string &filename, const double threshold) const
+{
+	std::ifstream file(filename);
+	if (!file.is_open()){
+		std::cerr << "ERROR: Unable to open baseline file '" << filename << "'." << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	const std::vector<std::string> timeMetrics   = {"loadTime", "buildTime", "solveTime", "wallTime"};
+	const std::vector<std::string> sizeMetrics   = {"peakMemoryKB", "columns", "rows", "nonzeros"};
+
+	std::cout << "=> Comparing against baseline " << filename << " (threshold: " << threshold*100 << "%) ..." << std::endl;
+	int nbRegressions = 0;
+	std::string line;
+	while (std::getline(file, line)){
+		std::string key = "\"name\": \"";
+		std::size_t pos = line.find(key);
+		if (pos == std::string::npos){
+			continue;
+		}
+		std::string name = line.substr(pos + key.size(), line.find('"', pos + key.size()) - pos - key.size());
+		std::string current = "";
+		for (unsigned int s = 0; s < results.size(); s++){
+			if (results[s].name == name){
+				std::ostringstream json;
+				writeJsonLine(json, results[s]);
+				current = json.str();
+			}
+		}
+		if (current.empty()){
+			std::cout << "\t WARNING: Step '" << name << "' is not part of the current ladder." << std::endl;
+			continue;
+		}
+		std::vector<std::string> metrics(timeMetrics);
+		metrics.insert(metrics.end(), sizeMetrics.begin(), sizeMetrics.end());
+		for (unsigned int m = 0; m < metrics.size(); m++){
+			double before = getJsonValue(line, metrics[m]);
+			double after = getJsonValue(current, metrics[m]);
+			if (std::isnan(before) || std::isnan(after)){
+				continue;
+			}
+			bool isTime = (m < timeMetrics.size());
+			if (isTime && after < BENCH_MIN_TIME){
+				continue;
+			}
+			if (after > before*(1.0 + threshold)){
+				std::cout << "\t REGRESSION: " << name << "." << metrics[m] << " went from " << before << " to " << after << std::endl;
+				nbRegressions++;
+			}
+		}
+		/* Objective values may only be compared when both runs proved optimality. */
+		if (line.find("\"status\": \"Optimal\"") != std::string::npos && current.find("\"status\": \"Optimal\"") != std::string::npos){
+			double before = getJsonValue(line, "objective");
+			double after = getJsonValue(current, "objective");
+			if (std::fabs(after - before) > EPS*std::max(1.0, std::fabs(before))){
+				std::cout << "\t REGRESSION: " << name << ".objective went from " << before << " to " << after << std::endl;
+				nbRegressions++;
+			}
+		}
+	}
+	file.close();
+	std::cout << "\t " << nbRegressions << " regression(s) found." << std::endl;
+	return nbRegressions;
+}
+
+/****************************************************************************************/
+/*										Resources										*/
+/****************************************************************************************/
+
+/* Returns the current wall-clock time in seconds. */
+double getWallTime()
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/* Resets the peak resident memory of the process, when supported by the system. */
+void resetPeakMemory()
+{
+	/* Writing 5 to clear_refs resets VmHWM (Linux >= 4.0). Older kernels keep the process-wide peak. */
+	std::ofstream clearRefs("/proc/self/clear_refs");
+	if (clearRefs.is_open()){
+		clearRefs << "5";
+		clearRefs.close();
+	}
+}
+
+/* Returns the peak resident memory of the process in kB. */
+long getPeakMemory()
+{
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)){
+		if (line.compare(0, 6, "VmHWM:") == 0){
+			return atol(line.substr(6).c_str());
+		}
+	}
+	return -1;
+}
+
+/* Returns the numeric value of a given key inside a JSON line, or NAN if not present. */
+double getJsonValue(const std::string &line, const std::string &key)
+{
+	std::string pattern = "\"" + key + "\": ";
+	std::size_t pos = line.find(pattern);
+	if (pos == std::string::npos){
+		return NAN;
+	}
+	const char* begin = line.c_str() + pos + pattern.size();
+	char* end = NULL;
+	double value = strtod(begin, &end);
+	if (end == begin){
+		return NAN;
+	}
+	return value;
+}
@@ -0,0 +1,127 @@
+#ifndef __benchmark__hpp
+#define __benchmark__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <chrono>
+#include <random>
+#include <sstream>
+
+/*** Own Libraries ***/
+#include "../instance/data.hpp"
+#include "../instance/presolve.hpp"
+#include "../solver/model.hpp"
+
+/****************************************************************************************/
+/*										CONSTANTS										*/
+/****************************************************************************************/
+#define BENCH_TIME_LIMIT 	60 		// Time limit (in seconds) applied to each solve of the ladder
+#define BENCH_MIN_TIME 		0.05 	// Times below this value (in seconds) are considered noise when comparing against a baseline
+#define BENCH_SEED 			1234 	// Seed used for generating the instances of the ladder
+
+
+/********************************************************************************************
+ * This structure describes one step of the benchmark ladder, that is, the size of a
+ * synthetic instance shaped like instances/testing: a set of RUs, each one connected to a
+ * few ECs, a ring (or a full mesh) of ECs and a single RC.
+********************************************************************************************/
+struct BenchmarkStep {
+	std::string name;		/**< Step name. **/
+	int 		nbRU;		/**< Number of RU nodes (one demand per RU). **/
+	int 		nbEC;		/**< Number of EC nodes. **/
+	int 		degreeRU;	/**< Number of ECs each RU is connected to. **/
+	bool 		symmetric;	/**< True if ECs form a full mesh instead of a ring, so that ECs reached by the same RUs are interchangeable. **/
+	bool 		symmetryBreaking;	/**< True if symmetry-breaking constraints are added to the model. **/
+};
+
+/********************************************************************************************
+ * This structure stores the measures taken on one step of the benchmark ladder.
+********************************************************************************************/
+struct BenchmarkResult {
+	std::string 				name;				/**< Step name. **/
+	int 						nbNodes;			/**< Number of nodes. **/
+	int 						nbLinks;			/**< Number of links. **/
+	int 						nbDemands;			/**< Number of demands. **/
+	double 						loadTime;			/**< Time (in seconds) spent on building the Data. **/
+	double 						buildTime;			/**< Time (in seconds) spent on building the Model. **/
+	std::vector<std::string> 	buildStepNames;		/**< Names of the model building steps. **/
+	std::vector<double> 		buildStepTimes;		/**< Time (in seconds) spent on each model building step. **/
+	double 						solveTime;			/**< Time (in seconds) spent on solving the Model. **/
+	double 						wallTime;			/**< Total time (in seconds) spent on the step. **/
+	long 						peakMemory;			/**< Peak resident memory (in kB) observed during the step. **/
+	long 						nbColumns;			/**< Number of columns extracted to Cplex. **/
+	long 						nbRows;				/**< Number of rows extracted to Cplex. **/
+	long 						nbNonZeros;			/**< Number of non-zeros extracted to Cplex. **/
+	std::string 				status;				/**< Cplex status at the end of the solve. **/
+	double 						objective;			/**< Best objective value found. **/
+	double 						gap;				/**< Relative MIP gap (in %) at the end of the solve. **/
+};
+
+/********************************************************************************************
+ * This class runs a fixed ladder of instance sizes through Data loading, Model construction
+ * and a time-capped solve. Results are written as JSON and may be compared against a
+ * baseline file produced by a previous run.
+********************************************************************************************/
+class Benchmark {
+
+private:
+	const std::string 				directory;		/**< Directory where the ladder instances are written. **/
+	std::vector<BenchmarkStep> 		ladder;			/**< The fixed ladder of instance sizes. **/
+	std::vector<BenchmarkResult> 	results;		/**< The measures taken on each step. **/
+
+public:
+	/****************************************************************************************/
+	/*										Constructor										*/
+	/****************************************************************************************/
+	/** Constructor. Defines the fixed ladder of instance sizes. @param dir The directory where the ladder instances are written. **/
+	Benchmark(const std::string &dir);
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+	/** Returns the measures taken on each step. **/
+	const std::vector<BenchmarkResult>& getResults() const { return results; }
+
+	/****************************************************************************************/
+	/*										Methods											*/
+	/****************************************************************************************/
+	/** Runs every step of the ladder. **/
+	void run();
+
+	/** Writes the instance files of a ladder step and returns the path of its parameter file. @param step The ladder step. **/
+	std::string writeInstance(const BenchmarkStep &step) const;
+
+	/** Runs a single ladder step and returns its measures. @param step The ladder step. **/
+	BenchmarkResult runStep(const BenchmarkStep &step) const;
+
+	/** Writes the measures of a single step as a one-line JSON object. @param out The output stream. @param result The step measures. **/
+	void writeJsonLine(std::ostream &out, const BenchmarkResult &result) const;
+
+	/** Writes the results as JSON. @param filename The output file. **/
+	void writeJson(const std::string &filename) const;
+
+	/** Compares the results against a baseline JSON file and returns the number of regressions found. @param filename The baseline file. @param threshold The relative increase tolerated before flagging a regression. **/
+	int compare(const std::string &filename, const double threshold) const;
+};
+
+/****************************************************************
+ * These are other useful methods for measuring resources.
+ * *************************************************************/
+
+/** Returns the current wall-clock time in seconds. **/
+double getWallTime();
+
+/** Resets the peak resident memory of the process, when supported by the system. **/
+void resetPeakMemory();
+
+/** Returns the peak resident memory of the process in kB. **/
+long getPeakMemory();
+
+/** Returns the numeric value of a given key inside a JSON line, or NAN if not present. @param line The JSON line. @param key The key to look for. **/
+double getJsonValue(const std::string &line, const std::string &key);
+
+#endif
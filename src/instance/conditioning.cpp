@@ -0,0 +1,97 @@
+#include "conditioning.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+Conditioning::Conditioning(const Data& data_, const std::vector<int>& demands_) :
+                data(data_), demands(demands_), throughputScale(1.0), costScale(1.0), latencyScale(1.0)
+{
+    /* By default, every demand is handled. */
+    if (demands.empty()){
+        for (int i = 0; i < data.getNbDemands(); i++){
+            demands.push_back(i);
+        }
+    }
+
+    std::vector<bool> used(data.getNbLinks(), false);
+    for (unsigned int d = 0; d < demands.size(); d++){
+        int i = demands[d];
+        throughputs.add(data.getDemand(i).getThroughput());
+        latencies.add(data.getDemand(i).getMaxLatency());
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            costs.add(candidates[c].getCost());
+            for (unsigned int l = 0; l < candidates[c].getListOfLinks().size(); l++){
+                used[candidates[c].getListOfLinks()[l]] = true;
+            }
+        }
+    }
+    for (unsigned int l = 0; l < used.size(); l++){
+        if (used[l] && data.isCapacityActive(l)){
+            capacities.add(data.getLink(l).getCapacity());
+        }
+        if (used[l] && data.hasLinkDelays()){
+            latencies.add(data.getLink(l).getDelay());
+        }
+    }
+
+    if (!data.getInput().isScaling()){
+        return;
+    }
+    /* Throughputs and capacities meet in the same rows: they share their unit. */
+    CoefficientRange bandwidth = throughputs;
+    if (!capacities.isEmpty()){
+        bandwidth.add(capacities.min);
+        bandwidth.add(capacities.max);
+    }
+    throughputScale = getScale(bandwidth);
+    costScale = getScale(costs);
+    latencyScale = getScale(latencies);
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Returns the power of 2 closest to the geometric mean of the range. */
+double Conditioning::getScale(const CoefficientRange& range)
+{
+    if (range.isEmpty()){
+        return 1.0;
+    }
+    int exponent = (int)std::lround(0.5 * (std::log2(range.min) + std::log2(range.max)));
+    return std::ldexp(1.0, exponent);
+}
+
+/* Displays the range of each family of coefficients, in original and model units. */
+void Conditioning::print() const
+{
+    std::cout << "\t > Coefficient ranges (original units -> model units): " << std::endl;
+    if (!costs.isEmpty()){
+        std::cout << "\t\t Objective: [" << costs.min << ", " << costs.max << "] -> ["
+                  << cost(costs.min) << ", " << cost(costs.max) << "] (cost unit " << costScale << ")" << std::endl;
+    }
+    std::cout << "\t\t Placement rows: [1, 1] -> [1, 1]" << std::endl;
+    if (!throughputs.isEmpty() && !capacities.isEmpty()){
+        std::cout << "\t\t Capacity rows: [" << throughputs.min << ", " << throughputs.max << "] -> ["
+                  << throughput(throughputs.min) << ", " << throughput(throughputs.max) << "], right-hand sides ["
+                  << capacities.min << ", " << capacities.max << "] -> [" << throughput(capacities.min) << ", "
+                  << throughput(capacities.max) << "] (throughput unit " << throughputScale << ")" << std::endl;
+    }
+    if (!throughputs.isEmpty() && data.getInput().isSymmetryBreaking()){
+        std::cout << "\t\t Symmetry rows: [" << throughputs.min << ", " << throughputs.max << "] -> ["
+                  << throughput(throughputs.min) << ", " << throughput(throughputs.max) << "]" << std::endl;
+    }
+    if (!latencies.isEmpty()){
+        std::cout << "\t\t Latencies: [" << latencies.min << ", " << latencies.max << "] -> ["
+                  << latency(latencies.min) << ", " << latency(latencies.max) << "] (latency unit " << latencyScale << ")" << std::endl;
+    }
+
+    /* The placement rows keep their 0/1 coefficients: the matrix range is measured against 1. */
+    if (!throughputs.isEmpty()){
+        double before = std::max(throughputs.max, 1.0) / std::min(throughputs.min, 1.0);
+        double after = std::max(throughput(throughputs.max), 1.0) / std::min(throughput(throughputs.min), 1.0);
+        std::cout << "\t\t Matrix range (max/min): " << before << " -> " << after << std::endl;
+    }
+}
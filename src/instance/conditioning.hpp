@@ -0,0 +1,100 @@
+#ifndef __conditioning__hpp
+#define __conditioning__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <cmath>
+
+/*** Own Libraries ***/
+#include "data.hpp"
+
+
+/********************************************************************************************
+ * This structure stores the range of the absolute values of a family of coefficients.
+********************************************************************************************/
+struct CoefficientRange {
+	double 	min;	/**< Smallest non-zero absolute value (DBL_MAX if none). **/
+	double 	max;	/**< Largest absolute value (0 if none). **/
+
+	CoefficientRange() : min(DBL_MAX), max(0.0) {}
+
+	/** Adds a coefficient to the range. Zeros are ignored. **/
+	void add(const double value) { if (value != 0.0){ min = std::min(min, std::fabs(value)); max = std::max(max, std::fabs(value)); } }
+
+	/** Returns true if no coefficient was added. **/
+	bool isEmpty() const { return max == 0.0; }
+};
+
+/********************************************************************************************
+ * This class chooses the units in which the model is written, so that its coefficients are
+ * close to 1. Throughputs and capacities share one scale (they meet in the capacity rows),
+ * costs and latencies have their own. Each scale is the power of 2 closest to the geometric
+ * mean of the smallest and the largest value it applies to, so that dividing by it only
+ * shifts exponents: no digit is lost, and results convert back to the original units
+ * exactly. The demands considered are the ones handled by the model (every demand if none
+ * is given), and the ranges of each family of coefficients can be reported before and after
+ * scaling.
+********************************************************************************************/
+class Conditioning
+{
+	private:
+		const Data&     		data;   			/**< Data read in data.hpp **/
+		std::vector<int> 		demands;			/**< Demands handled by the model. **/
+		double 					throughputScale;	/**< Unit of throughputs and capacities. **/
+		double 					costScale;			/**< Unit of costs. **/
+		double 					latencyScale;		/**< Unit of latencies and delays. **/
+
+		CoefficientRange 		costs;				/**< Placement costs (objective). **/
+		CoefficientRange 		throughputs;		/**< Throughputs (capacity and symmetry rows). **/
+		CoefficientRange 		capacities;			/**< Capacities of the active links used (capacity right-hand sides). **/
+		CoefficientRange 		latencies;			/**< Maximum latencies and link delays. **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. Chooses the scales for the given demands (every demand if empty). **/
+		Conditioning(const Data& data, const std::vector<int>& demands = std::vector<int>());
+		Conditioning(const Data&&, const std::vector<int>& demands = std::vector<int>()) = delete;
+		Conditioning() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns the unit of throughputs and capacities. **/
+		double getThroughputScale() const { return throughputScale; }
+
+		/** Returns the unit of costs. **/
+		double getCostScale() const { return costScale; }
+
+		/** Returns the unit of latencies and delays. **/
+		double getLatencyScale() const { return latencyScale; }
+
+		/** Returns a throughput or a capacity in model units. **/
+		double throughput(const double value) const { return value / throughputScale; }
+
+		/** Returns a cost in model units. **/
+		double cost(const double value) const { return value / costScale; }
+
+		/** Returns a latency or a delay in model units. **/
+		double latency(const double value) const { return value / latencyScale; }
+
+		/** Returns a cost given in model units in the original units. **/
+		double unscaleCost(const double value) const { return value * costScale; }
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Returns the power of 2 closest to the geometric mean of the range (1 if empty). **/
+		static double getScale(const CoefficientRange& range);
+
+		/** Displays the range of each family of coefficients, in original and model units. **/
+		void print() const;
+};
+
+
+#endif
@@ -5,16 +5,15 @@
 /****************************************************************************************/
 
 /** Constructor. **/
-Data::Data(const std::string &parameter_file) : params(parameter_file)
+Data::Data(const std::string &parameter_file) : params(parameter_file), linkDelays(false)
 {
-	std::cout << "=> Defining data ..." << std::endl;
-	readNodeFile(params.getNodeFile());
-	readLinkFile(params.getLinkFile());
-	readDemandFile(params.getDemandFile());
+	build();
+}
 
-	buildGraph();
-	std::cout << "\t Data was correctly constructed !" << std::endl;
-	
+/** Constructor. **/
+Data::Data(const Input &input) : params(input), linkDelays(false)
+{
+	build();
 }
 
 /****************************************************************************************/
@@ -23,9 +22,9 @@ Data::Data(const std::string &parameter_file) : params(parameter_file)
 /* Returns the id from the node with the given name. */
 const int Data::getIdFromNodeName(const std::string name) const
 {
-	auto search = hashNode.find(name);
-    if (search != hashNode.end()) {
-        return search->second;
+	int id = store.findNode(name);
+    if (id >= 0) {
+        return id;
     } 
 	else {
         std::cerr << "ERROR: Could not find a node with name '"<< name << "'... Abort." << std::endl;
@@ -66,9 +65,60 @@ const bool Data::areNeighbors(const Graph::Node &u, const Graph::Node &v) const
 	return false;
 }
 
+/* Returns the index of the candidate of demand i with the given DU and CU nodes, or -1 if there is none. */
+const int Data::getCandidateIndex(const int i, const int du, const int cu) const
+{
+	for (unsigned int c = 0; c < tabCandidates[i].size(); c++){
+		if (tabCandidates[i][c].getDU() == du && tabCandidates[i][c].getCU() == cu){
+			return c;
+		}
+	}
+	return -1;
+}
+
+/****************************************************************************************/
+/*										Setters 										*/
+/****************************************************************************************/
+/* Stores the placement found by a solver in the demands. */
+void Data::setPlacement(const std::vector<int>& placement)
+{
+	for (int i = 0; i < store.getNbDemands(); i++){
+		store.demandCandidate[i] = placement[i];
+		store.demandDU[i] = (placement[i] < 0) ? -1 : tabCandidates[i][placement[i]].getDU();
+		store.demandCU[i] = (placement[i] < 0) ? -1 : tabCandidates[i][placement[i]].getCU();
+	}
+}
+
 /****************************************************************************************/
 /*										Builders 										*/
 /****************************************************************************************/
+/* Reads the instance files and builds the graph and the placement candidates. */
+void Data::build()
+{
+	std::cout << "=> Defining data ..." << std::endl;
+	readNodeFile(params.getNodeFile());
+	readLinkFile(params.getLinkFile());
+	readDemandFile(params.getDemandFile());
+	std::cout << "\t Network store: " << store.getMemory() << " bytes";
+	if (getNbDemands() > 0){
+		std::cout << " (" << store.getMemory() / getNbDemands() << " per demand)";
+	}
+	std::cout << "." << std::endl;
+	if (!params.getScenarioFile().empty()){
+		readThroughputFile(params.getScenarioFile(), "scenario", tabScenarios);
+	}
+	if (!params.getPeriodFile().empty()){
+		readThroughputFile(params.getPeriodFile(), "period", tabPeriods);
+	}
+
+	buildGraph();
+	buildCandidates();
+	if (linkDelays){
+		pruneLatencyCandidates();
+	}
+	std::cout << "\t Data was correctly constructed !" << std::endl;
+}
+
 
 /* Reads the node file and fills the set of nodes. */
 void Data::readNodeFile(const std::string filename)
@@ -84,13 +134,11 @@ void Data::readNodeFile(const std::string filename)
 	std::vector<std::vector<std::string> > dataList = reader.getData();
 	// skip the first line (headers)
 	for (unsigned int i = 1; i < dataList.size(); i++)	{
-		int nodeId = (int)i - 1;
-		std::string nodeName = dataList[i][0];
-		std::string nodeType = dataList[i][1];
+		const std::string& nodeName = dataList[i][0];
+		const std::string& nodeType = dataList[i][1];
 		double costCU = atof(dataList[i][2].c_str()); 
 		double costDU = atof(dataList[i][3].c_str());
-		this->tabNodes.push_back(Node(nodeId, nodeName, nodeType, costCU, costDU));
-		hashNode.insert({nodeName, nodeId});
+		store.addNode(nodeName, nodeType, costCU, costDU);
 	}
 
 }
@@ -107,14 +155,16 @@ void Data::readLinkFile(const std::string filename)
 	/* dataList is a vector of vectors of strings. */
 	/* dataList[0] corresponds to the first line of the document and dataList[0][i] to the i-th word.*/
 	std::vector<std::vector<std::string> > dataList = reader.getData();
+	/* The propagation delay column is optional: name;source;target;link_capacity;delay; */
+	linkDelays = (!dataList.empty() && dataList[0].size() > 4 && dataList[0][4] == "delay");
 	// skip the first line (headers)
 	for (unsigned int i = 1; i < dataList.size(); i++)	{
-		int linkId = (int)i - 1;
-		std::string linkName = dataList[i][0];
+		const std::string& linkName = dataList[i][0];
 		int source = getIdFromNodeName(dataList[i][1]);
 		int target = getIdFromNodeName(dataList[i][2]);
 		double linkCapacity = atof(dataList[i][3].c_str());;
-		this->tabLinks.push_back(Link(linkId, linkName, source, target, linkCapacity));
+		double linkDelay = (linkDelays && dataList[i].size() > 4) ? atof(dataList[i][4].c_str()) : 0.0;
+		store.addLink(linkName, source, target, linkCapacity, linkDelay);
 	}
 }
 
@@ -132,16 +182,59 @@ void Data::readDemandFile(const std::string filename)
 	std::vector<std::vector<std::string> > dataList = reader.getData();
 	// skip the first line (headers)
 	for (unsigned int i = 1; i < dataList.size(); i++)	{
-		int demandId = (int)i - 1;
-		std::string demandName = dataList[i][0];
+		const std::string& demandName = dataList[i][0];
 		int source = getIdFromNodeName(dataList[i][1]);
 		double maxLatency = atof(dataList[i][2].c_str());
 		double throughput = atof(dataList[i][3].c_str());
-		this->tabDemands.push_back(Demand(demandId, demandName, source, maxLatency, throughput));
+		store.addDemand(demandName, source, maxLatency, throughput);
 	}
 }
 
-/* Builds the network graph from data stored in tabNodes and tabLinks. */
+/* Reads a throughput table (scenarios or periods) and fills the throughput of each demand in each column. */
+void Data::readThroughputFile(const std::string filename, const std::string column, std::vector<std::vector<double> >& table)
+{
+    std::cout << "\t Reading " << filename << " ..."  << std::endl;
+	Reader reader(filename);
+	std::vector<std::vector<std::string> > dataList = reader.getData();
+	/* The header names the columns: name;s1;s2;... */
+	int nbColumns = dataList.empty() ? 0 : (int)dataList[0].size() - 1;
+	while (nbColumns > 0 && dataList[0][nbColumns].empty()){
+		nbColumns--;
+	}
+	if (nbColumns <= 0){
+		std::cerr << "ERROR: The " << column << " file '" << filename << "' does not contain any " << column << "." << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	table.assign(getNbDemands(), std::vector<double>());
+	// skip the first line (headers)
+	for (unsigned int row = 1; row < dataList.size(); row++){
+		if (dataList[row].empty() || dataList[row][0].empty()){
+			continue;
+		}
+		int i = getIdFromDemandName(dataList[row][0]);
+		if (i < 0){
+			std::cerr << "ERROR: Could not find a demand with name '" << dataList[row][0] << "' in " << column << " file... Abort." << std::endl;
+			exit(EXIT_FAILURE);
+		}
+		if ((int)dataList[row].size() <= nbColumns){
+			std::cerr << "ERROR: Demand '" << dataList[row][0] << "' does not have a throughput for each " << column << "... Abort." << std::endl;
+			exit(EXIT_FAILURE);
+		}
+		std::vector<double>& throughputs = table[i];
+		for (int col = 1; col <= nbColumns; col++){
+			throughputs.push_back(atof(dataList[row][col].c_str()));
+		}
+	}
+	for (int i = 0; i < getNbDemands(); i++){
+		if (table[i].empty()){
+			std::cerr << "ERROR: Demand '" << getDemand(i).getName() << "' is missing from " << column << " file... Abort." << std::endl;
+			exit(EXIT_FAILURE);
+		}
+	}
+	std::cout << "\t " << nbColumns << " throughput " << column << "(s) were read." << std::endl;
+}
+
+/* Builds the network graph from the nodes and links of the store. */
 void Data::buildGraph()
 {
 	
@@ -154,17 +247,17 @@ void Data::buildGraph()
 	lemonArcId = new ArcMap(*graph);
 	
 	/* Define nodes */
-	for (unsigned int i = 0; i < tabNodes.size(); i++){
+	for (int i = 0; i < getNbNodes(); i++){
         Graph::Node n = graph->addNode();
-        setNodeId(n, tabNodes[i].getId());
+        setNodeId(n, i);
         setLemonNodeId(n, graph->id(n));
-		assert(tabNodes[i].getId() == graph->id(n));
+		assert(i == graph->id(n));
     }
 
 	/* Define arcs */
-	for (unsigned int i = 0; i < tabLinks.size(); i++){
-        int source = tabLinks[i].getSource();
-        int target = tabLinks[i].getTarget();
+	for (int i = 0; i < getNbLinks(); i++){
+        int source = store.linkSource[i];
+        int target = store.linkTarget[i];
         Graph::Node sourceNode = lemon::INVALID;
         Graph::Node targetNode = lemon::INVALID;
         for (NodeIt v(getGraph()); v != lemon::INVALID; ++v){
@@ -178,12 +271,361 @@ void Data::buildGraph()
         if (targetNode != lemon::INVALID && sourceNode != lemon::INVALID){
             Arc a = graph->addArc(sourceNode, targetNode);
             setLemonArcId(a, graph->id(a));
-            setArcId(a, tabLinks[i].getId());
-			assert(graph->id(a) == tabLinks[i].getId());
+            setArcId(a, i);
+			assert(graph->id(a) == i);
         }
     }
 }
 
+/* Builds the placement candidates of each demand. */
+void Data::buildCandidates()
+{
+	if (params.getNbPaths() > 0){
+		buildPathCandidates();
+		return;
+	}
+	std::cout << "\t Creating placement candidates..." << std::endl;
+	tabCandidates.clear();
+	tabCandidates.resize(getNbDemands());
+	tabCapacityActive.assign(getNbLinks(), true);
+	std::vector<int> lastSeen(getNbNodes(), -1);
+	std::vector<std::vector<int> > linksTo(getNbNodes());
+	long nbCandidates = 0;
+	for (int i = 0; i < getNbDemands(); i++){
+		Graph::Node ruNode = getGraph().nodeFromId(store.demandSource[i]);
+		/* The DU is placed either on the RU itself or on one of its out-neighbors. */
+		std::vector<Graph::Node> duNodes(1, ruNode);
+		for (Graph::OutArcIt a(getGraph(), ruNode); a != lemon::INVALID; ++a){
+			duNodes.push_back(getGraph().target(a));
+		}
+		for (unsigned int d = 0; d < duNodes.size(); d++){
+			int j = getNodeId(duNodes[d]);
+			/* Parallel arcs must not create duplicated candidates. */
+			if (lastSeen[j] == (int)i){
+				continue;
+			}
+			lastSeen[j] = i;
+			double costDU = getDistributedUnitPlacementCost(getNode(j));
+			/* The CU is placed either on the DU node itself (no link used) or on one of its out-neighbors. */
+			tabCandidates[i].push_back(Candidate(j, j, costDU + getCentralUnitPlacementCost(getNode(j))));
+			std::vector<int> cuOrder;
+			for (Graph::OutArcIt a(getGraph(), duNodes[d]); a != lemon::INVALID; ++a){
+				int k = getNodeId(getGraph().target(a));
+				if (k == j){
+					continue;
+				}
+				if (linksTo[k].empty()){
+					cuOrder.push_back(k);
+				}
+				linksTo[k].push_back(getArcId(a));
+			}
+			for (unsigned int c = 0; c < cuOrder.size(); c++){
+				int k = cuOrder[c];
+				tabCandidates[i].push_back(Candidate(j, k, costDU + getCentralUnitPlacementCost(getNode(k)), linksTo[k]));
+				linksTo[k].clear();
+			}
+		}
+		nbCandidates += tabCandidates[i].size();
+	}
+	std::cout << "\t " << nbCandidates << " placement candidates were created." << std::endl;
+}
+
+/* Builds the placement candidates of each demand from the path table. */
+void Data::buildPathCandidates()
+{
+	std::cout << "\t Creating multi-hop placement candidates..." << std::endl;
+	tabCandidates.clear();
+	tabCandidates.resize(getNbDemands());
+	tabCapacityActive.assign(getNbLinks(), true);
+	pathStart.assign(1, 0);
+	pathLinks.clear();
+	pathTarget.clear();
+	pathsFrom.assign(getNbNodes(), std::vector<int>());
+	std::vector<bool> searched(getNbNodes(), false);
+
+	/* Fronthaul paths leave the RUs; midhaul paths leave every node they reach, and the RUs themselves. */
+	std::vector<int> sources;
+	for (int i = 0; i < getNbDemands(); i++){
+		int ru = store.demandSource[i];
+		if (!searched[ru]){
+			searched[ru] = true;
+			sources.push_back(ru);
+		}
+	}
+	buildPaths(sources);
+	std::vector<int> duNodes;
+	for (int p = 0; p < getNbPaths(); p++){
+		if (!searched[pathTarget[p]]){
+			searched[pathTarget[p]] = true;
+			duNodes.push_back(pathTarget[p]);
+		}
+	}
+	buildPaths(duNodes);
+	std::cout << "\t " << getNbPaths() << " paths were stored (" << pathLinks.size() << " links)." << std::endl;
+
+	/* A candidate is a DU node with its fronthaul path (none on the RU itself) and a CU node with its midhaul path (none on the DU itself).
+	   The two paths must not share a link: the capacity rows count each link of a candidate once. */
+	long nbCandidates = 0, nbOverlapping = 0;
+	for (int i = 0; i < getNbDemands(); i++){
+		int ru = store.demandSource[i];
+		std::vector<int> fronthauls(1, -1);
+		fronthauls.insert(fronthauls.end(), pathsFrom[ru].begin(), pathsFrom[ru].end());
+		for (unsigned int f = 0; f < fronthauls.size(); f++){
+			int j = (fronthauls[f] < 0) ? ru : pathTarget[fronthauls[f]];
+			double costDU = getDistributedUnitPlacementCost(getNode(j));
+			std::vector<int> midhauls(1, -1);
+			midhauls.insert(midhauls.end(), pathsFrom[j].begin(), pathsFrom[j].end());
+			for (unsigned int m = 0; m < midhauls.size(); m++){
+				int k = (midhauls[m] < 0) ? j : pathTarget[midhauls[m]];
+				std::vector<int> links;
+				const int used[2] = {fronthauls[f], midhauls[m]};
+				for (int u = 0; u < 2; u++){
+					if (used[u] >= 0){
+						links.insert(links.end(), pathLinks.begin() + pathStart[used[u]], pathLinks.begin() + pathStart[used[u] + 1]);
+					}
+				}
+				std::vector<int> sorted(links);
+				std::sort(sorted.begin(), sorted.end());
+				if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()){
+					nbOverlapping++;
+					continue;
+				}
+				tabCandidates[i].push_back(Candidate(j, k, costDU + getCentralUnitPlacementCost(getNode(k)), links));
+			}
+		}
+		nbCandidates += tabCandidates[i].size();
+	}
+	std::cout << "\t " << nbCandidates << " placement candidates were created (" << nbOverlapping << " dropped as their fronthaul and midhaul paths share a link)." << std::endl;
+}
+
+/* Drops the candidates whose propagation delay alone exceeds the maximum latency of their demand. */
+void Data::pruneLatencyCandidates()
+{
+	std::cout << "\t Pruning candidates by propagation delay..." << std::endl;
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	/* Each RU is searched up to the largest maximum latency among its demands. With multi-hop paths, the delays
+	   of the links of the candidates are exact, so no search is needed. */
+	std::vector<int> sources;
+	std::vector<double> bounds;
+	std::vector<int> position(getNbNodes(), -1);
+	if (params.getNbPaths() == 0){
+		for (int i = 0; i < getNbDemands(); i++){
+			int ru = store.demandSource[i];
+			if (position[ru] < 0){
+				position[ru] = sources.size();
+				sources.push_back(ru);
+				bounds.push_back(0.0);
+			}
+			bounds[position[ru]] = std::max(bounds[position[ru]], store.demandMaxLatency[i]);
+		}
+	}
+
+	int nbThreads = params.getNbThreads();
+	if (nbThreads <= 0){
+		nbThreads = std::max(1, (int)std::thread::hardware_concurrency());
+	}
+	nbThreads = std::min(nbThreads, (int)sources.size());
+	std::vector<std::vector<double> > delays(sources.size());
+	std::vector<std::thread> threads;
+	for (int t = 0; t < nbThreads; t++){
+		int first = (sources.size() * t) / nbThreads;
+		int last = (sources.size() * (t + 1)) / nbThreads;
+		threads.push_back(std::thread(&Data::searchDelays, this, std::cref(sources), std::cref(bounds), first, last, std::ref(delays)));
+	}
+	for (unsigned int t = 0; t < threads.size(); t++){
+		threads[t].join();
+	}
+
+	/* The shortest delay from the RU bounds the delay to reach the DU, and the delay to reach the CU through it. With
+	   multi-hop paths, the links of a candidate are its whole route, so their delays add up to its exact delay. */
+	long nbBefore = 0, nbAfter = 0;
+	for (int i = 0; i < getNbDemands(); i++){
+		double maxLatency = store.demandMaxLatency[i] * (1.0 + LATENCY_TOLERANCE);
+		std::vector<Candidate> kept;
+		for (unsigned int c = 0; c < tabCandidates[i].size(); c++){
+			const Candidate& candidate = tabCandidates[i][c];
+			const std::vector<int>& links = candidate.getListOfLinks();
+			double bound = 0.0;
+			if (params.getNbPaths() > 0){
+				for (unsigned int l = 0; l < links.size(); l++){
+					bound += store.linkDelay[links[l]];
+				}
+			}
+			else{
+				/* The links of a candidate are the parallel DU-CU links: the fastest one gives the midhaul delay. */
+				double midhaul = links.empty() ? 0.0 : DBL_MAX;
+				for (unsigned int l = 0; l < links.size(); l++){
+					midhaul = std::min(midhaul, store.linkDelay[links[l]]);
+				}
+				const std::vector<double>& delay = delays[position[store.demandSource[i]]];
+				bound = std::max(delay[candidate.getCU()], delay[candidate.getDU()] + midhaul);
+			}
+			if (bound <= maxLatency){
+				kept.push_back(candidate);
+			}
+		}
+		nbBefore += tabCandidates[i].size();
+		nbAfter += kept.size();
+		if (kept.empty()){
+			std::cout << "WARNING: Demand '" << getDemand(i).getName() << "' has no candidate within its maximum latency." << std::endl;
+		}
+		tabCandidates[i] = kept;
+	}
+	double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	std::cout << "\t Candidates: " << nbBefore << " -> " << nbAfter << " (" << nbBefore - nbAfter << " over the maximum latency, "
+	          << sources.size() << " RU(s) searched in " << time << " seconds)." << std::endl;
+}
+
+/* Computes the shortest propagation delay from sources[first, last) to every node, up to the given bounds. */
+void Data::searchDelays(const std::vector<int>& sources, const std::vector<double>& bounds, const int first, const int last, std::vector<std::vector<double> >& delays) const
+{
+	Graph::ArcMap<double> length(getGraph());
+	for (ArcIt a(getGraph()); a != lemon::INVALID; ++a){
+		length[a] = store.linkDelay[getArcId(a)];
+	}
+	lemon::Dijkstra<Graph, Graph::ArcMap<double> > dijkstra(getGraph(), length);
+	for (int s = first; s < last; s++){
+		/* The search stops as soon as the next node is farther than the bound: the nodes left out are out of reach. */
+		dijkstra.init();
+		dijkstra.addSource(getGraph().nodeFromId(sources[s]));
+		while (!dijkstra.emptyQueue() && dijkstra.currentDist(dijkstra.nextNode()) <= bounds[s] * (1.0 + LATENCY_TOLERANCE)){
+			dijkstra.processNextNode();
+		}
+		delays[s].assign(getNbNodes(), DBL_MAX);
+		for (NodeIt n(getGraph()); n != lemon::INVALID; ++n){
+			if (dijkstra.processed(n)){
+				delays[s][getNodeId(n)] = dijkstra.dist(n);
+			}
+		}
+	}
+}
+
+/* Fills the path table with the k shortest paths of at most maxHops links leaving each of the given nodes. */
+void Data::buildPaths(const std::vector<int>& sources)
+{
+	if (sources.empty()){
+		return;
+	}
+	int nbThreads = params.getNbThreads();
+	if (nbThreads <= 0){
+		nbThreads = std::max(1, (int)std::thread::hardware_concurrency());
+	}
+	nbThreads = std::min(nbThreads, (int)sources.size());
+
+	/* Sources are split in contiguous blocks; each thread owns its length map and Dijkstra object. */
+	std::vector<std::vector<std::vector<Arc> > > found(sources.size());
+	std::vector<std::thread> threads;
+	for (int t = 0; t < nbThreads; t++){
+		int first = (sources.size() * t) / nbThreads;
+		int last = (sources.size() * (t + 1)) / nbThreads;
+		threads.push_back(std::thread(&Data::searchPaths, this, std::cref(sources), first, last, std::ref(found)));
+	}
+	for (unsigned int t = 0; t < threads.size(); t++){
+		threads[t].join();
+	}
+
+	/* Paths are appended in the order of the sources, so that the table does not depend on the number of threads. */
+	for (unsigned int s = 0; s < sources.size(); s++){
+		for (unsigned int p = 0; p < found[s].size(); p++){
+			for (unsigned int h = 0; h < found[s][p].size(); h++){
+				pathLinks.push_back(getArcId(found[s][p][h]));
+			}
+			pathStart.push_back(pathLinks.size());
+			pathTarget.push_back(getNodeId(getGraph().target(found[s][p].back())));
+			pathsFrom[sources[s]].push_back(pathTarget.size() - 1);
+		}
+	}
+}
+
+/* Computes the k shortest paths leaving sources[first, last), as lists of arcs per source. */
+void Data::searchPaths(const std::vector<int>& sources, const int first, const int last, std::vector<std::vector<std::vector<Arc> > >& found) const
+{
+	const unsigned int K = params.getNbPaths();
+	const int MAX_HOPS = params.getMaxHops();
+	/* Every arc counts for one hop; an arc taken out of a spur search gets a length no real path can reach. */
+	const double BLOCKED = getGraph().maxArcId() + 2.0;
+	Graph::ArcMap<double> length(getGraph(), 1.0);
+	lemon::Dijkstra<Graph, Graph::ArcMap<double> > dijkstra(getGraph(), length);
+
+	for (int s = first; s < last; s++){
+		Graph::Node source = getGraph().nodeFromId(sources[s]);
+
+		/* Shortest path to every node within reach, from a single search. */
+		dijkstra.run(source);
+		std::vector<std::vector<Arc> > shortest;
+		for (NodeIt n(getGraph()); n != lemon::INVALID; ++n){
+			Graph::Node v = n;
+			if (v == source || !dijkstra.reached(v) || dijkstra.dist(v) > MAX_HOPS){
+				continue;
+			}
+			std::vector<Arc> path;
+			for (Graph::Node u = v; u != source; u = getGraph().source(dijkstra.predArc(u))){
+				path.push_back(dijkstra.predArc(u));
+			}
+			std::reverse(path.begin(), path.end());
+			shortest.push_back(path);
+		}
+
+		/* Yen's algorithm: the next path to a target deviates from a previous one at some spur node. */
+		for (unsigned int t = 0; t < shortest.size(); t++){
+			Graph::Node target = getGraph().target(shortest[t].back());
+			std::vector<std::vector<Arc> > accepted(1, shortest[t]);
+			std::vector<std::vector<Arc> > pending;
+			while (accepted.size() < K){
+				const std::vector<Arc> previous = accepted.back();
+				for (unsigned int i = 0; i < previous.size(); i++){
+					Graph::Node spur = (i == 0) ? source : getGraph().target(previous[i-1]);
+					std::vector<Arc> blocked;
+					/* The arcs leaving the spur node along accepted paths sharing the same root are taken out... */
+					for (unsigned int a = 0; a < accepted.size(); a++){
+						if (accepted[a].size() > i && std::equal(previous.begin(), previous.begin() + i, accepted[a].begin())){
+							blocked.push_back(accepted[a][i]);
+						}
+					}
+					/* ... and so are the nodes of the root, which the spur path must not cross again. */
+					for (unsigned int r = 0; r < i; r++){
+						for (Graph::OutArcIt a(getGraph(), getGraph().source(previous[r])); a != lemon::INVALID; ++a){
+							blocked.push_back(a);
+						}
+					}
+					for (unsigned int b = 0; b < blocked.size(); b++){
+						length[blocked[b]] = BLOCKED;
+					}
+					if (dijkstra.run(spur, target) && dijkstra.dist(target) < BLOCKED && (int)(i + dijkstra.dist(target)) <= MAX_HOPS){
+						std::vector<Arc> spurPath;
+						for (Graph::Node u = target; u != spur; u = getGraph().source(dijkstra.predArc(u))){
+							spurPath.push_back(dijkstra.predArc(u));
+						}
+						std::vector<Arc> path(previous.begin(), previous.begin() + i);
+						path.insert(path.end(), spurPath.rbegin(), spurPath.rend());
+						if (std::find(pending.begin(), pending.end(), path) == pending.end() &&
+							std::find(accepted.begin(), accepted.end(), path) == accepted.end()){
+							pending.push_back(path);
+						}
+					}
+					for (unsigned int b = 0; b < blocked.size(); b++){
+						length[blocked[b]] = 1.0;
+					}
+				}
+				if (pending.empty()){
+					break;
+				}
+				/* The fewest hops first; ties keep the order in which the paths were found. */
+				unsigned int best = 0;
+				for (unsigned int p = 1; p < pending.size(); p++){
+					if (pending[p].size() < pending[best].size()){
+						best = p;
+					}
+				}
+				accepted.push_back(pending[best]);
+				pending.erase(pending.begin() + best);
+			}
+			found[s].insert(found[s].end(), accepted.begin(), accepted.end());
+		}
+	}
+}
+
 /****************************************************************************************/
 /*										Display											*/
 /****************************************************************************************/
@@ -199,8 +641,8 @@ void Data::printNodes(){
     std::cout << "-------------------------------------------------------------------" << std::endl;
     std::cout << "-                              NODES                              -" << std::endl;
     std::cout << "-------------------------------------------------------------------" << std::endl;
-	for (unsigned int i = 0; i < tabNodes.size(); i++){
-        tabNodes[i].print();
+	for (int i = 0; i < getNbNodes(); i++){
+        getNode(i).print();
     }
 	std::cout << std::endl;
 }
@@ -208,8 +650,8 @@ void Data::printLinks(){
     std::cout << "-------------------------------------------------------------------" << std::endl;
     std::cout << "-                              LINKS                              -" << std::endl;
     std::cout << "-------------------------------------------------------------------" << std::endl;
-	for (unsigned int i = 0; i < tabLinks.size(); i++){
-        tabLinks[i].print();
+	for (int i = 0; i < getNbLinks(); i++){
+        getLink(i).print();
     }
 	std::cout << std::endl;
 }
@@ -218,12 +660,56 @@ void Data::printDemands(){
     std::cout << "-------------------------------------------------------------------" << std::endl;
     std::cout << "-                             DEMANDS                             -" << std::endl;
     std::cout << "-------------------------------------------------------------------" << std::endl;
-	for (unsigned int i = 0; i < tabDemands.size(); i++){
-        tabDemands[i].print();
+	for (int i = 0; i < getNbDemands(); i++){
+        getDemand(i).print();
     }
 	std::cout << std::endl;
 }
 
+/* Writes the placement stored in the demands to the placement file. */
+void Data::writePlacementFile(const std::string& name) const
+{
+	std::string filename = name.empty() ? params.getPlacementFile() : name;
+	if (filename.empty()){
+		return;
+	}
+	std::ofstream file(filename.c_str(), std::ios_base::trunc);
+	if (!file){
+		std::cerr << "ERROR: Unable to access placement file '" << filename << "'." << std::endl;
+		exit(EXIT_FAILURE);
+	}
+
+	/* Utilization of a link: throughput routed through it over its capacity. */
+	std::vector<double> load(getNbLinks(), 0.0);
+	for (int i = 0; i < getNbDemands(); i++){
+		const std::vector<int>& links = getDemand(i).getListOfLinks();
+		for (unsigned int l = 0; l < links.size(); l++){
+			load[links[l]] += store.demandThroughput[i];
+		}
+	}
+
+	file << "demand;du;cu;links;utilization;" << std::endl;
+	for (int i = 0; i < getNbDemands(); i++){
+		Demand demand = getDemand(i);
+		if (demand.getCandidate() < 0){
+			file << demand.getName() << ";;;;;" << std::endl;
+			continue;
+		}
+		std::string links = "", utilization = "";
+		const std::vector<int>& route = demand.getListOfLinks();
+		for (unsigned int l = 0; l < route.size(); l++){
+			int link = route[l];
+			std::string separator = (l > 0) ? "," : "";
+			links += separator + getLink(link).getName();
+			utilization += separator + std::to_string(load[link] / store.linkCapacity[link]);
+		}
+		file << demand.getName() << ";" << getNode(demand.getDU()).getName() << ";" << getNode(demand.getCU()).getName() << ";"
+		     << links << ";" << utilization << ";" << std::endl;
+	}
+	file.close();
+	std::cout << "=> Placement written to " << filename << "." << std::endl;
+}
+
 /****************************************************************************************/
 /*										Destructor										*/
 /****************************************************************************************/
@@ -231,10 +717,9 @@ void Data::printDemands(){
 /** Desstructor. **/
 Data::~Data()
 {
-    this->tabLinks.clear();
-    this->tabNodes.clear();
-	this->hashNode.clear();
-	this->tabDemands.clear();
+    this->store.clear();
+	this->tabCandidates.clear();
+	this->tabCapacityActive.clear();
 	delete nodeId;
 	delete lemonNodeId;
 	delete arcId;
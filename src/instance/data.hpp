@@ -12,15 +12,20 @@
 #include <algorithm>
 #include <cmath>
 #include <assert.h>
+#include <thread>
+#include <chrono>
 
 /*** LEMON Libraries ***/     
 #include <lemon/list_graph.h>
+#include <lemon/dijkstra.h>
 
 /*** Own Libraries ***/  
 #include "input.hpp"
 #include "../network/demand.hpp"
 #include "../network/node.hpp"
 #include "../network/link.hpp"
+#include "../network/store.hpp"
+#include "../network/candidate.hpp"
 #include "../tools/reader.hpp"
 
 
@@ -41,6 +46,60 @@ typedef Graph::ArcIt 		ArcIt;
 typedef Graph::NodeMap<int> NodeMap;
 typedef Graph::ArcMap<int> ArcMap;
 
+
+/****************************************************************************************/
+/*										CONSTANTS										*/
+/****************************************************************************************/
+#define LATENCY_TOLERANCE 	1e-9 	// Relative slack on the maximum latency, against rounding in the sum of link delays
+
+class Data;
+
+/********************************************************************************************
+ * A read-only sequence of views (Node, Link or Demand) over the rows of the network store.
+ * It is indexed and iterated like the vector it stands for, each element being built on
+ * access, so that no copy of the store is made.
+********************************************************************************************/
+template <typename View>
+class StoreRange
+{
+	public:
+		typedef View (Data::*Getter)(const int) const;
+
+		/** Iterator over the views of the range. **/
+		class const_iterator
+		{
+			private:
+				const StoreRange* 	range;		/**< The range iterated. **/
+				int 				position;	/**< Id of the current element. **/
+			public:
+				const_iterator(const StoreRange* r, const int p) : range(r), position(p) {}
+				View operator*() const { return (*range)[position]; }
+				const_iterator& operator++() { position++; return *this; }
+				bool operator==(const const_iterator& other) const { return position == other.position; }
+				bool operator!=(const const_iterator& other) const { return position != other.position; }
+		};
+
+	private:
+		const Data* 	data;		/**< The data holding the store. **/
+		int 			nbElements;	/**< Number of elements of the range. **/
+		Getter 			get;		/**< Builds the view on an element from its id. **/
+
+	public:
+		/** Constructor. @param d The data holding the store. @param n The number of elements. @param g Builds the view on an element from its id. **/
+		StoreRange(const Data* d, const int n, Getter g) : data(d), nbElements(n), get(g) {}
+
+		/** Returns the number of elements. **/
+		size_t size() const { return nbElements; }
+		/** Returns true if the range has no element. **/
+		bool empty() const { return nbElements == 0; }
+		/** Returns a view on the i-th element. **/
+		View operator[](const int i) const { return (data->*get)(i); }
+		/** Returns an iterator on the first element. **/
+		const_iterator begin() const { return const_iterator(this, 0); }
+		/** Returns an iterator past the last element. **/
+		const_iterator end() const { return const_iterator(this, nbElements); }
+};
+
 /********************************************************************************************
  * This class stores the data needed for modeling an instance of the Resilient SFC routing 
  * and VNF placement problem. This consists of a network graph, 											
@@ -49,9 +108,16 @@ class Data {
 
 private:
 	Input 				params;						/**< Input parameters. **/
-    std::vector<Node> 	tabNodes;         			/**< Set of nodes. **/
-	std::vector<Link> 	tabLinks;					/**< Set of links. **/
-	std::vector<Demand> tabDemands;					/**< Set of demands. **/
+	NetworkStore 		store;						/**< Fields of the nodes, links and demands, one array per field. **/
+	std::vector<std::vector<Candidate> > tabCandidates; /**< Set of placement candidates of each demand. **/
+	std::vector<bool> 	tabCapacityActive;			/**< True if the capacity row of the link may bind. **/
+	std::vector<std::vector<double> > tabScenarios;	/**< Throughput of each demand in each scenario (empty if no scenario file). **/
+	std::vector<std::vector<double> > tabPeriods;	/**< Throughput of each demand in each period (empty if no period file). **/
+	std::vector<int> 	pathStart;					/**< Position in pathLinks of the first link of each path, plus one final entry. **/
+	std::vector<int> 	pathLinks;					/**< Links of every path, path after path. **/
+	std::vector<int> 	pathTarget;					/**< Last node of each path. **/
+	std::vector<std::vector<int> > pathsFrom;		/**< Paths leaving each node, grouped by target and by increasing number of links within a group. **/
+	bool 				linkDelays;					/**< True if the link file gives the propagation delay of each link. **/
 
 	Graph* 				graph;						/**< The network graph. **/
 	NodeMap* 			nodeId;						/**< A map storing the nodes' ids. **/
@@ -59,7 +125,6 @@ private:
 	ArcMap* 			arcId;						/**< A map storing the arcs' ids. **/
 	ArcMap* 			lemonArcId;					/**< A map storing the arcs' lemon ids. **/
 
-	std::unordered_map<std::string, int> hashNode; 	/**< A map for locating node id's from its name. **/
 public:
 
 	/****************************************************************************************/
@@ -69,6 +134,9 @@ public:
 	/** Constructor initializes the object with the information of an Input. @param parameter_file The parameters file.**/
 	Data(const std::string &parameter_file);
 
+	/** Constructor initializes the object with the information of an already read Input. @param input The input parameters. **/
+	Data(const Input &input);
+
 
 	/****************************************************************************************/
 	/*										Getters											*/
@@ -80,16 +148,30 @@ public:
 	const NodeMap& 			 	getLemonNodeIds  () const { return *lemonNodeId; }				/**< Returns a reference to the map storing the nodes' lemon ids. */
 	const ArcMap& 			 	getArcIds    	 () const { return *arcId; }					/**< Returns a reference to the map storing the arcs' ids. */
 	const ArcMap& 			 	getLemonArcIds   () const { return *lemonArcId; }				/**< Returns a reference to the map storing the arcs' lemon ids. */
-	const std::vector<Node>& 	getNodes     	 () const { return tabNodes; }					/**< Returns a reference to the vector of nodes. */
-	const std::vector<Link>& 	getLinks     	 () const { return tabLinks; }					/**< Returns a reference to the vector of arcs. */
-	const std::vector<Demand>&  getDemands     	 () const { return tabDemands; }				/**< Returns a reference to the vector of demands. */
-	const int  					getNbNodes     	 () const { return (int)tabNodes.size(); }		/**< Returns the number of nodes. */
-	const int  					getNbDemands   	 () const { return (int)tabDemands.size(); }	/**< Returns the number of demands. */
-
-
-	const Demand& 	getDemand 		(const int i) 	const { return tabDemands[i]; }				/**< Returns a reference to the i-th demand. */
-	const Link& 	getLink   		(const int i) 	const { return tabLinks[i]; }				/**< Returns a reference to the i-th arc. */
-	const Node& 	getNode   		(const int i) 	const { return tabNodes[i]; }				/**< Returns a reference to the i-th node. */
+	const NetworkStore& 		getStore     	 () const { return store; }						/**< Returns a reference to the store holding the fields of the nodes, links and demands. */
+	StoreRange<Node> 			getNodes     	 () const { return StoreRange<Node>(this, getNbNodes(), &Data::getNode); }		/**< Returns a view on the sequence of nodes. */
+	StoreRange<Link> 			getLinks     	 () const { return StoreRange<Link>(this, getNbLinks(), &Data::getLink); }		/**< Returns a view on the sequence of arcs. */
+	StoreRange<Demand> 			getDemands     	 () const { return StoreRange<Demand>(this, getNbDemands(), &Data::getDemand); }	/**< Returns a view on the sequence of demands. */
+	const int  					getNbNodes     	 () const { return store.getNbNodes(); }		/**< Returns the number of nodes. */
+	const int  					getNbLinks     	 () const { return store.getNbLinks(); }		/**< Returns the number of links. */
+	const int  					getNbDemands   	 () const { return store.getNbDemands(); }		/**< Returns the number of demands. */
+	const std::vector<Candidate>& getCandidates (const int i) const { return tabCandidates[i]; }	/**< Returns a reference to the placement candidates of the i-th demand. */
+	const bool 					isCapacityActive (const int l) const { return tabCapacityActive[l]; }	/**< Returns true if the capacity row of the l-th link may bind. */
+	const int 					getNbScenarios   () const { return tabScenarios.empty() ? 0 : (int)tabScenarios[0].size(); }	/**< Returns the number of throughput scenarios (0 if none). */
+	const double 				getScenarioThroughput (const int i, const int s) const { return tabScenarios[i][s]; }	/**< Returns the throughput of the i-th demand in the s-th scenario. */
+	const int 					getNbPeriods     () const { return tabPeriods.empty() ? 0 : (int)tabPeriods[0].size(); }	/**< Returns the number of periods (0 if none). */
+	const double 				getPeriodThroughput (const int i, const int t) const { return tabPeriods[i][t]; }	/**< Returns the throughput of the i-th demand in the t-th period. */
+	const bool 					hasLinkDelays    () const { return linkDelays; }	/**< Returns true if the link file gives the propagation delay of each link. */
+	const int 					getNbPaths       () const { return (int)pathTarget.size(); }	/**< Returns the number of paths in the path table (0 without multi-hop). */
+	const std::vector<int>& 	getPathsFrom     (const int v) const { return pathsFrom[v]; }	/**< Returns the paths leaving the v-th node. */
+	const int 					getPathTarget    (const int p) const { return pathTarget[p]; }	/**< Returns the last node of the p-th path. */
+	const int 					getPathSize      (const int p) const { return pathStart[p+1] - pathStart[p]; }	/**< Returns the number of links of the p-th path. */
+	const int 					getPathLink      (const int p, const int h) const { return pathLinks[pathStart[p] + h]; }	/**< Returns the h-th link of the p-th path. */
+
+
+	Demand 			getDemand 		(const int i) 	const { return Demand(&store, &tabCandidates, i); }			/**< Returns a view on the i-th demand. */
+	Link 			getLink   		(const int i) 	const { return Link(&store, i); }			/**< Returns a view on the i-th arc. */
+	Node 			getNode   		(const int i) 	const { return Node(&store, i); }			/**< Returns a view on the i-th node. */
 
 	const int& 		getNodeId   	(const Graph::Node& v) const { return (*nodeId)[v]; }		/**< Returns the id of a given node. */
 	const int& 		getLemonNodeId 	(const Graph::Node& v) const { return (*lemonNodeId)[v]; }	/**< Returns the lemon id of a given node. */
@@ -98,6 +180,9 @@ public:
 
 	/** Returns the id from the node with the given name. @param name The node name. **/
 	const int getIdFromNodeName(const std::string name) const;
+
+	/** Returns the id from the demand with the given name, or -1 if there is none. @param name The demand name. **/
+	const int getIdFromDemandName(const std::string& name) const { return store.findDemand(name); }
 	
 	/** Returns the cost of placing a central unit on the given node. @param node The target node. **/
 	const double getCentralUnitPlacementCost(const Node& node) const;
@@ -108,6 +193,9 @@ public:
 	/** Checks if node v is in the neighborhood of node u in the graph. **/
 	const bool areNeighbors(const Graph::Node& u, const Graph::Node& v) const;
 
+	/** Returns the index of the candidate of demand i with the given DU and CU nodes, or -1 if there is none. **/
+	const int getCandidateIndex(const int i, const int du, const int cu) const;
+
 	/****************************************************************************************/
 	/*										Setters											*/
 	/****************************************************************************************/
@@ -115,6 +203,11 @@ public:
 	void setLemonNodeId (const Graph::Node& v, const int &id) { (*lemonNodeId)[v] = id; }	/**< Sets the lemon id of a given node on the node map. */
 	void setArcId 		(const Graph::Arc& a, const int &id)  { (*arcId)[a] = id; }			/**< Sets the id of a given arc on the arc map. */
 	void setLemonArcId 	(const Graph::Arc& a, const int &id)  { (*lemonArcId)[a] = id; }	/**< Sets the lemon id of a given arc on the arc map. */
+	void setCandidates 	(const int i, const std::vector<Candidate>& c) { tabCandidates[i] = c; }	/**< Replaces the placement candidates of the i-th demand. */
+	void setCapacityActive (const int l, const bool active) { tabCapacityActive[l] = active; }	/**< Sets whether the capacity row of the l-th link may bind. */
+
+	/** Stores the placement found by a solver in the demands: DU, CU and links used. @param placement The chosen candidate of each demand (-1 if none). **/
+	void setPlacement(const std::vector<int>& placement);
 
 
 	/****************************************************************************************/
@@ -130,9 +223,33 @@ public:
 	/** Reads the demand file and fills the set of demands. @param filename The demand file to be read. **/
 	void readDemandFile(const std::string filename);
 
-	/** Builds the network graph from data stored in tabNodes and tabLinks. **/
+	/** Reads a throughput table: one line per demand name with its throughput in each column. @param filename The file to be read. @param column What a column stands for (scenario or period). @param table The table to be filled. **/
+	void readThroughputFile(const std::string filename, const std::string column, std::vector<std::vector<double> >& table);
+
+	/** Builds the network graph from the nodes and links of the store. **/
 	void buildGraph();
 
+	/** Reads the instance files and builds the graph and the placement candidates. **/
+	void build();
+
+	/** Builds the placement candidates of each demand: the DU must be in the neighborhood of the RU and the CU in the neighborhood of the DU. **/
+	void buildCandidates();
+
+	/** Builds the placement candidates of each demand from the path table: the DU is reached from the RU, and the CU from the DU, through one of their k shortest paths that share no link. **/
+	void buildPathCandidates();
+
+	/** Drops the candidates whose propagation delay alone exceeds the maximum latency of their demand. **/
+	void pruneLatencyCandidates();
+
+	/** Computes the shortest propagation delay from sources[first, last) to every node, up to the given bounds (DBL_MAX beyond). **/
+	void searchDelays(const std::vector<int>& sources, const std::vector<double>& bounds, const int first, const int last, std::vector<std::vector<double> >& delays) const;
+
+	/** Fills the path table with the k shortest paths of at most maxHops links leaving each of the given nodes. **/
+	void buildPaths(const std::vector<int>& sources);
+
+	/** Computes the k shortest paths leaving sources[first, last), as lists of arcs per source. **/
+	void searchPaths(const std::vector<int>& sources, const int first, const int last, std::vector<std::vector<std::vector<Arc> > >& found) const;
+
 
 	/****************************************************************************************/
 	/*										Display											*/
@@ -146,6 +263,9 @@ public:
 	/** Prints demand information. **/
 	void printDemands();
 
+	/** Writes the placement stored in the demands to the placement file: one line per demand with its DU, CU, links used and the utilization of each of these links. @param filename The file to be written (the placement file of the parameters if empty). **/
+	void writePlacementFile(const std::string& filename = "") const;
+
 	/****************************************************************************************/
 	/*										Destructor										*/
 	/****************************************************************************************/
@@ -0,0 +1,149 @@
+#include "feasibility.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+Feasibility::Feasibility(const Data& data_) : data(data_), oversized(data_.getNbDemands(), false), time(0.0)
+{
+}
+
+/****************************************************************************************/
+/*										Checks											*/
+/****************************************************************************************/
+
+/* Reports the demands without any placement candidate. */
+void Feasibility::checkCandidates()
+{
+    for (int i = 0; i < data.getNbDemands(); i++){
+        if (data.getCandidates(i).empty()){
+            reasons.push_back("Demand '" + data.getDemand(i).getName() + "' has no placement candidate: no DU and CU within reach of its RU node '"
+                              + data.getNode(data.getDemand(i).getSource()).getName() + "' and its maximum latency.");
+        }
+    }
+}
+
+/* Reports the demands whose every candidate uses a link with less capacity than their throughput. */
+void Feasibility::checkThroughputs()
+{
+    std::vector<int> lastSeen(data.getNbLinks(), -1);
+    for (int i = 0; i < data.getNbDemands(); i++){
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        double throughput = data.getDemand(i).getThroughput();
+        std::vector<std::string> links;
+        bool fits = false;
+        for (unsigned int c = 0; c < candidates.size() && !fits; c++){
+            fits = true;
+            const std::vector<int>& route = candidates[c].getListOfLinks();
+            for (unsigned int l = 0; l < route.size(); l++){
+                double capacity = data.getLink(route[l]).getCapacity();
+                if (throughput > capacity*(1.0 + FEASIBILITY_TOLERANCE)){
+                    fits = false;
+                    if (lastSeen[route[l]] != i){
+                        lastSeen[route[l]] = i;
+                        links.push_back("'" + data.getLink(route[l]).getName() + "' (capacity " + formatNumber(capacity) + ")");
+                    }
+                }
+            }
+        }
+        if (!candidates.empty() && !fits){
+            oversized[i] = true;
+            reasons.push_back("Demand '" + data.getDemand(i).getName() + "' (throughput " + formatNumber(throughput) + ") exceeds the capacity of a link on each of its "
+                              + std::to_string(candidates.size()) + " candidate(s): links " + listNames(links) + ".");
+        }
+    }
+}
+
+/* Reports the RU nodes whose demands cannot all leave them within the capacity of their outgoing links. */
+void Feasibility::checkSourceEgress()
+{
+    /* A demand leaves its RU node if none of its candidates keeps both the DU and the CU on it. */
+    std::vector<std::vector<int> > leaving(data.getNbNodes());
+    for (int i = 0; i < data.getNbDemands(); i++){
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        int ru = data.getDemand(i).getSource();
+        bool leaves = !candidates.empty() && !oversized[i];
+        for (unsigned int c = 0; c < candidates.size() && leaves; c++){
+            bool outgoing = false;
+            const std::vector<int>& route = candidates[c].getListOfLinks();
+            for (unsigned int l = 0; l < route.size() && !outgoing; l++){
+                outgoing = (data.getLink(route[l]).getSource() == ru);
+            }
+            leaves = outgoing;
+        }
+        if (leaves){
+            leaving[ru].push_back(i);
+        }
+    }
+
+    std::vector<int> lastSeen(data.getNbLinks(), -1);
+    for (int ru = 0; ru < data.getNbNodes(); ru++){
+        if (leaving[ru].empty()){
+            continue;
+        }
+        /* Each of these demands uses at least one of the links leaving the RU node on its candidates. */
+        double egress = 0.0, capacity = 0.0;
+        std::vector<std::string> demands, links;
+        for (unsigned int d = 0; d < leaving[ru].size(); d++){
+            int i = leaving[ru][d];
+            egress += data.getDemand(i).getThroughput();
+            demands.push_back("'" + data.getDemand(i).getName() + "'");
+            const std::vector<Candidate>& candidates = data.getCandidates(i);
+            for (unsigned int c = 0; c < candidates.size(); c++){
+                const std::vector<int>& route = candidates[c].getListOfLinks();
+                for (unsigned int l = 0; l < route.size(); l++){
+                    if (data.getLink(route[l]).getSource() == ru && lastSeen[route[l]] != ru){
+                        lastSeen[route[l]] = ru;
+                        capacity += data.getLink(route[l]).getCapacity();
+                        links.push_back("'" + data.getLink(route[l]).getName() + "'");
+                    }
+                }
+            }
+        }
+        if (egress > capacity*(1.0 + FEASIBILITY_TOLERANCE)){
+            reasons.push_back("RU node '" + data.getNode(ru).getName() + "' must send " + formatNumber(egress) + " through links " + listNames(links)
+                              + " (total capacity " + formatNumber(capacity) + ") for demands " + listNames(demands) + ".");
+        }
+    }
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Runs every check. */
+void Feasibility::run()
+{
+    std::cout << "=> Checking feasibility ..." << std::endl;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    reasons.clear();
+    checkCandidates();
+    if (data.getNbScenarios() == 0 && data.getNbPeriods() == 0){
+        checkThroughputs();
+        checkSourceEgress();
+    }
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* Displays the reasons found. */
+void Feasibility::print() const
+{
+    for (unsigned int r = 0; r < reasons.size(); r++){
+        std::cout << "\t " << reasons[r] << std::endl;
+    }
+    std::cout << "=> Feasibility check done in " << time << " seconds: "
+              << (isInfeasible() ? "the instance is infeasible." : "no certificate of infeasibility.") << std::endl;
+}
+
+/* Returns the given names separated by commas, the ones beyond FEASIBILITY_MAX_NAMES being only counted. */
+std::string Feasibility::listNames(const std::vector<std::string>& names)
+{
+    std::string list = "";
+    for (unsigned int n = 0; n < names.size() && n < FEASIBILITY_MAX_NAMES; n++){
+        list += (n > 0 ? ", " : "") + names[n];
+    }
+    if (names.size() > FEASIBILITY_MAX_NAMES){
+        list += " and " + std::to_string(names.size() - FEASIBILITY_MAX_NAMES) + " other(s)";
+    }
+    return list;
+}
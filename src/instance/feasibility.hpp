@@ -0,0 +1,89 @@
+#ifndef __feasibility__hpp
+#define __feasibility__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <chrono>
+
+/*** Own Libraries ***/
+#include "data.hpp"
+#include "../tools/others.hpp"
+
+/****************************************************************************************/
+/*										CONSTANTS										*/
+/****************************************************************************************/
+#define FEASIBILITY_TOLERANCE 	1e-10 	// Relative tolerance used when comparing throughputs against link capacities
+#define FEASIBILITY_MAX_NAMES 	10 		// Number of names listed in a reason before the others are only counted
+
+
+/********************************************************************************************
+ * This class looks for simple certificates of infeasibility in Data before any model is
+ * built, so that an infeasible instance is rejected at once instead of after a full solve:
+ *  - a demand without any placement candidate (no DU and CU within reach and latency);
+ *  - a demand whose every candidate uses a link with less capacity than its throughput;
+ *  - an RU node whose demands must all leave it, while their total throughput exceeds the
+ *    capacity of the links they may leave through.
+ * Each certificate is kept as a reason naming the nodes, links and demands involved.
+ * The checks on throughputs use the nominal ones, so they are skipped under scenarios or
+ * periods.
+********************************************************************************************/
+class Feasibility
+{
+	private:
+		const Data&     			data;   			/**< Data read in data.hpp **/
+		std::vector<std::string> 	reasons;			/**< Why the instance is infeasible (empty if no certificate was found). **/
+		std::vector<bool> 			oversized;			/**< True if no candidate of the demand fits the link capacities on its own. **/
+		double 						time;				/**< Time (in seconds) spent on the analysis. **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. @param data The data to be analysed. **/
+		Feasibility(const Data& data);
+		Feasibility(const Data&&) = delete;
+		Feasibility() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns true if the analysis proved the instance infeasible. **/
+		bool isInfeasible() const { return !reasons.empty(); }
+
+		/** Returns why the instance is infeasible. **/
+		const std::vector<std::string>& getReasons() const { return reasons; }
+
+		/** Returns the time (in seconds) spent on the analysis. **/
+		const double& getTime() const { return time; }
+
+	/****************************************************************************************/
+	/*										Checks											*/
+	/****************************************************************************************/
+		/** Reports the demands without any placement candidate. **/
+		void checkCandidates();
+
+		/** Reports the demands whose every candidate uses a link with less capacity than their throughput. **/
+		void checkThroughputs();
+
+		/** Reports the RU nodes whose demands cannot all leave them within the capacity of their outgoing links. **/
+		void checkSourceEgress();
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Runs every check. **/
+		void run();
+
+		/** Displays the reasons found. **/
+		void print() const;
+
+		/** Returns the given names separated by commas, the ones beyond FEASIBILITY_MAX_NAMES being only counted. **/
+		static std::string listNames(const std::vector<std::string>& names);
+};
+
+
+#endif
@@ -14,7 +14,137 @@ Input::Input(const std::string filename) : parameters_file(filename){
 
     linear_relaxation = std::stoi(getParameterValue("linearRelaxation="));
     time_limit        = std::stoi(getParameterValue("timeLimit="));
+    solver            = getParameterValue("solver=");
+    if (solver.empty()){
+        solver = "cplex";
+    }
+    if (solver != "cplex" && solver != "bb"){
+        std::cerr << "ERROR: Unknown solver '" << solver << "'. Please choose between 'cplex' and 'bb'." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    lp_solver         = getParameterValue("lpSolver=");
+    if (lp_solver.empty()){
+        lp_solver = "cplex";
+    }
+    if (lp_solver != "cplex" && lp_solver != "native"){
+        std::cerr << "ERROR: Unknown LP solver '" << lp_solver << "'. Please choose between 'cplex' and 'native'." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::string check = getParameterValue("lpCheck=");
+    lp_check          = check.empty() ? false : std::stoi(check);
+    std::string reduce = getParameterValue("presolve=");
+    presolve          = reduce.empty() ? false : std::stoi(reduce);
+    std::string breaking = getParameterValue("symmetry=");
+    symmetry          = breaking.empty() ? false : std::stoi(breaking);
+    std::string covers = getParameterValue("coverCuts=");
+    cover_cuts        = covers.empty() ? false : std::stoi(covers);
+    std::string units = getParameterValue("scaling=");
+    scaling           = units.empty() ? false : std::stoi(units);
+    std::string split = getParameterValue("decomposition=");
+    decomposition     = split.empty() ? false : std::stoi(split);
+    build             = getParameterValue("build=");
+    if (build.empty()){
+        build = "concert";
+    }
+    if (build != "concert" && build != "bulk"){
+        std::cerr << "ERROR: Unknown build mode '" << build << "'. Please choose between 'concert' and 'bulk'." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    warm_start_dir    = getParameterValue("warmStartDir=");
+    portfolio_file    = getParameterValue("portfolio=");
+    cplex_params      = getParameterValue("cplexParams=");
+    tuning_dir        = getParameterValue("tuning=");
+    tuning_file       = getParameterValue("tuningFile=");
+    std::string points = getParameterValue("paretoPoints=");
+    pareto_points     = points.empty() ? 0 : std::stoi(points);
+    pareto_file       = getParameterValue("paretoFile=");
+    scenario_file     = getParameterValue("scenarioFile=");
+    std::string coverage = getParameterValue("scenarioCoverage=");
+    scenario_coverage = coverage.empty() ? 1.0 : std::stod(coverage);
+    if (scenario_coverage <= 0.0 || scenario_coverage > 1.0){
+        std::cerr << "ERROR: The scenario coverage must be in (0, 1]." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (!scenario_file.empty() && linear_relaxation){
+        std::cerr << "ERROR: Throughput scenarios require an integral solve (linearRelaxation=0)." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    online_trace      = getParameterValue("onlineTrace=");
+    std::string period = getParameterValue("reoptimizePeriod=");
+    reoptimize_period = period.empty() ? 10.0 : std::stod(period);
+    if (reoptimize_period < 0.0){
+        std::cerr << "ERROR: The re-optimization period must be non-negative." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    period_file       = getParameterValue("periodFile=");
+    std::string window = getParameterValue("horizon=");
+    horizon           = window.empty() ? 3 : std::stoi(window);
+    if (horizon < 1){
+        std::cerr << "ERROR: The rolling horizon must span at least one period." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::string penalty = getParameterValue("reassignmentPenalty=");
+    reassignment_penalty = penalty.empty() ? 1.0 : std::stod(penalty);
+    schedule_file     = getParameterValue("scheduleFile=");
+    if (!period_file.empty() && (linear_relaxation || !scenario_file.empty())){
+        std::cerr << "ERROR: The multi-period mode requires an integral solve without throughput scenarios." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::string paths = getParameterValue("kPaths=");
+    k_paths           = paths.empty() ? 0 : std::stoi(paths);
+    std::string hops  = getParameterValue("maxHops=");
+    max_hops          = hops.empty() ? 3 : std::stoi(hops);
+    if (k_paths < 0 || max_hops < 1){
+        std::cerr << "ERROR: The number of paths must be non-negative and the number of hops positive." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    /* Ties between paths are broken by arc order, so the candidate sets of interchangeable nodes may differ. */
+    if (k_paths > 0 && symmetry){
+        std::cout << "WARNING: Symmetry breaking is turned off with multi-hop paths." << std::endl;
+        symmetry = false;
+    }
+    std::string dives = getParameterValue("dives=");
+    nb_dives          = dives.empty() ? 0 : std::stoi(dives);
+    if (nb_dives < 0){
+        std::cerr << "ERROR: The number of dives must be non-negative." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (nb_dives > 0 && (!scenario_file.empty() || !period_file.empty())){
+        std::cerr << "ERROR: LP-guided dives require a single throughput per demand (no scenarios or periods)." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::string fixing = getParameterValue("reducedCostFixing=");
+    reduced_cost_fixing = fixing.empty() ? false : std::stoi(fixing);
+    if (reduced_cost_fixing && (linear_relaxation || build != "concert")){
+        std::cerr << "ERROR: Reduced-cost fixing requires an integral solve (linearRelaxation=0) on the concert build." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::string pool  = getParameterValue("poolSize=");
+    pool_size         = pool.empty() ? 0 : std::stoi(pool);
+    std::string poolGap = getParameterValue("poolGap=");
+    pool_gap          = poolGap.empty() ? 0.05 : std::stod(poolGap);
+    if (pool_size < 0 || pool_gap < 0.0){
+        std::cerr << "ERROR: The pool size and the pool gap must be non-negative." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    if (pool_size > 0 && (linear_relaxation || build != "concert" || !scenario_file.empty() || !period_file.empty() || !online_trace.empty() || pareto_points > 0 || !portfolio_file.empty())){
+        std::cerr << "ERROR: The solution pool requires a single integral solve on the concert build (no scenarios, periods, online trace, Pareto sweep or portfolio)." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    /* Both remove placements that are as cheap as the ones kept, which are the alternatives the pool is after. */
+    if (pool_size > 0 && (symmetry || presolve)){
+        std::cout << "WARNING: Presolve and symmetry breaking are turned off with the solution pool." << std::endl;
+        symmetry = false;
+        presolve = false;
+    }
+    if (!tuning_dir.empty() && tuning_file.empty()){
+        std::cerr << "ERROR: A tuning file MUST be declared in the parameters file when tuning is requested." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    std::string threads = getParameterValue("threads=");
+    nb_threads        = threads.empty() ? 0 : std::stoi(threads);
     output_file       = getParameterValue("outputFile=");
+    placement_file    = getParameterValue("placementFile=");
 
     print();
 }
@@ -60,6 +190,58 @@ void Input::print(){
     else{
         std::cout << "FALSE" << std::endl;
     }
+    if (linear_relaxation){
+        std::cout << "\t LP Solver: " << lp_solver << (lp_check ? " (checked against CPLEX)" : "") << std::endl;
+    }
     std::cout << "\t Time Limit: " << time_limit << " seconds" << std::endl;
+    std::cout << "\t Solver: " << solver << std::endl;
+    std::cout << "\t Presolve: " << (presolve ? "TRUE" : "FALSE") << std::endl;
+    std::cout << "\t Symmetry Breaking: " << (symmetry ? "TRUE" : "FALSE") << std::endl;
+    std::cout << "\t Cover Cuts: " << (cover_cuts ? "TRUE" : "FALSE") << std::endl;
+    std::cout << "\t Scaling: " << (scaling ? "TRUE" : "FALSE") << std::endl;
+    std::cout << "\t Decomposition: " << (decomposition ? "TRUE" : "FALSE") << std::endl;
+    std::cout << "\t Build: " << build << std::endl;
+    std::cout << "\t Reduced-cost Fixing: " << (reduced_cost_fixing ? "TRUE" : "FALSE") << std::endl;
+    if (pool_size > 0){
+        std::cout << "\t Solution Pool: " << pool_size << " placement(s) within " << pool_gap*100 << "% of the best" << std::endl;
+    }
+    if (k_paths > 0){
+        std::cout << "\t Multi-hop Paths: " << k_paths << " shortest path(s) of at most " << max_hops << " hop(s)" << std::endl;
+    }
+    if (nb_dives > 0){
+        std::cout << "\t LP-guided Dives: " << nb_dives << std::endl;
+    }
+    if (!cplex_params.empty()){
+        std::cout << "\t Cplex Parameters: " << cplex_params << std::endl;
+    }
+    if (!tuning_dir.empty()){
+        std::cout << "\t Tuning: " << tuning_dir << " (saved to " << tuning_file << ")" << std::endl;
+    }
+    if (!scenario_file.empty()){
+        std::cout << "\t Scenarios: " << scenario_file << " (coverage " << scenario_coverage << ")" << std::endl;
+    }
+    if (!period_file.empty()){
+        std::cout << "\t Periods: " << period_file << " (horizon " << horizon << ", reassignment penalty " << reassignment_penalty << ")" << std::endl;
+    }
+    if (!online_trace.empty()){
+        std::cout << "\t Online Trace: " << online_trace << " (re-optimized every " << reoptimize_period << " seconds)" << std::endl;
+    }
+    if (pareto_points > 0){
+        std::cout << "\t Pareto Sweep: " << pareto_points << " points (written to " << pareto_file << ")" << std::endl;
+    }
+    if (!portfolio_file.empty()){
+        std::cout << "\t Portfolio: " << portfolio_file << std::endl;
+    }
+    if (!warm_start_dir.empty()){
+        std::cout << "\t Warm Start Store: " << warm_start_dir << std::endl;
+    }
+    std::cout << "\t Threads: ";
+    if (nb_threads > 0){
+        std::cout << nb_threads << std::endl;
+    }
+    else{
+        std::cout << "ALL" << std::endl;
+    }
     std::cout << "\t Output File: " << output_file << std::endl;
+    std::cout << "\t Placement File: " << placement_file << std::endl;
 }
\ No newline at end of file
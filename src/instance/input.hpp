@@ -24,9 +24,41 @@ private:
 	/***** Optimization parameters*****/
     bool                linear_relaxation;
     int                 time_limit;
+    std::string         solver;
+    int                 nb_threads;
+    std::string         lp_solver;
+    bool                lp_check;
+    bool                presolve;
+    bool                symmetry;
+    bool                cover_cuts;
+    bool                scaling;
+    bool                decomposition;
+    std::string         build;
+    std::string         warm_start_dir;
+    std::string         portfolio_file;
+    std::string         cplex_params;
+    std::string         tuning_dir;
+    std::string         tuning_file;
+    int                 pareto_points;
+    std::string         pareto_file;
+    std::string         scenario_file;
+    double              scenario_coverage;
+    std::string         online_trace;
+    std::string         period_file;
+    int                 horizon;
+    double              reassignment_penalty;
+    std::string         schedule_file;
+    int                 k_paths;
+    int                 max_hops;
+    int                 nb_dives;
+    bool                reduced_cost_fixing;
+    int                 pool_size;
+    double              pool_gap;
+    double              reoptimize_period;
 
     /***** Output file paths *****/
     std::string         output_file;
+    std::string         placement_file;
     
 public:
 	/********************************************/
@@ -62,9 +94,111 @@ public:
     /** Returns time limit in seconds to be applied. */
     const int&         getTimeLimit()      const { return this->time_limit; }
 
+    /** Returns the solver to be used: 'cplex' (MIP solved through Concert) or 'bb' (combinatorial branch-and-bound). */
+    const std::string& getSolver()         const { return this->solver; }
+
+    /** Returns the solver used for the linear relaxation: 'cplex' (simplex through Concert) or 'native' (first-order solver). */
+    const std::string& getLpSolver()       const { return this->lp_solver; }
+
+    /** Returns true if the native linear relaxation value is to be checked against CPLEX. */
+    const bool&        isLpCheck()         const { return this->lp_check; }
+
+    /** Returns true if the problem-specific presolve is to be applied before solving. */
+    const bool&        isPresolve()        const { return this->presolve; }
+
+    /** Returns true if symmetry-breaking constraints are to be added for interchangeable nodes. */
+    const bool&        isSymmetryBreaking() const { return this->symmetry; }
+
+    /** Returns true if lifted cover cuts are to be separated on the link capacity rows. */
+    const bool&        isCoverCuts()       const { return this->cover_cuts; }
+
+    /** Returns true if throughputs, capacities, costs and latencies are to be rescaled so that model coefficients are close to 1. */
+    const bool&        isScaling()         const { return this->scaling; }
+
+    /** Returns true if independent components of the instance are to be solved separately. */
+    const bool&        isDecomposition()   const { return this->decomposition; }
+
+    /** Returns how the CPLEX model is built: 'concert' (expression by expression) or 'bulk' (flat arrays loaded through the callable library). */
+    const std::string& getBuild()          const { return this->build; }
+
+    /** Returns the directory of the warm-start store (empty if no warm start is to be used). */
+    const std::string& getWarmStartDir()   const { return this->warm_start_dir; }
+
+    /** Returns the file listing the Cplex configurations run concurrently by the portfolio (no portfolio if empty). */
+    const std::string& getPortfolioFile()  const { return this->portfolio_file; }
+
+    /** Returns the Cplex parameter file (.prm) loaded before solving (none if empty). */
+    const std::string& getCplexParamFile() const { return this->cplex_params; }
+
+    /** Returns the directory of instances over which Cplex parameters are tuned (no tuning if empty). */
+    const std::string& getTuningDir()      const { return this->tuning_dir; }
+
+    /** Returns the Cplex parameter file (.prm) where the tuned settings are saved. */
+    const std::string& getTuningFile()     const { return this->tuning_file; }
+
+    /** Returns the number of points of the cost versus peak utilization frontier (no sweep if 0). */
+    const int&         getParetoPoints()   const { return this->pareto_points; }
+
+    /** Returns the file where the frontier is written. */
+    const std::string& getParetoFile()     const { return this->pareto_file; }
+
+    /** Returns the file holding the throughput of each demand in each scenario (no scenario if empty). */
+    const std::string& getScenarioFile()   const { return this->scenario_file; }
+
+    /** Returns the fraction of scenarios in which the placement must fit the link capacities. */
+    const double&      getScenarioCoverage() const { return this->scenario_coverage; }
+
+    /** Returns the trace of arrivals and departures replayed by the online engine (offline solve if empty). */
+    const std::string& getOnlineTrace()    const { return this->online_trace; }
+
+    /** Returns the period (in seconds) of the background re-optimizations of the online engine (none if 0). */
+    const double&      getReoptimizePeriod() const { return this->reoptimize_period; }
+
+    /** Returns the file holding the throughput of each demand in each period (single period if empty). */
+    const std::string& getPeriodFile()     const { return this->period_file; }
+
+    /** Returns the number of periods of the rolling horizon. */
+    const int&         getHorizon()        const { return this->horizon; }
+
+    /** Returns the cost of moving a demand to another candidate between two consecutive periods. */
+    const double&      getReassignmentPenalty() const { return this->reassignment_penalty; }
+
+    /** Returns the file where the placement committed in each period is written (none if empty). */
+    const std::string& getScheduleFile()   const { return this->schedule_file; }
+
+    /** Returns the number of shortest paths kept between each pair of nodes for multi-hop placement (direct neighborhood if 0). */
+    const int&         getNbPaths()        const { return this->k_paths; }
+
+    /** Returns the largest number of links on a fronthaul or midhaul path. */
+    const int&         getMaxHops()        const { return this->max_hops; }
+
+    /** Returns the number of LP-guided dives run before solving (none if 0). */
+    const int&         getNbDives()        const { return this->nb_dives; }
+
+    /** Returns true if the z columns priced out by the root LP are fixed to 0 before the MIP solve. */
+    const bool&        isReducedCostFixing() const { return this->reduced_cost_fixing; }
+
+    /** Returns the number of best distinct placements collected in the solution pool (none if 0). */
+    const int&         getPoolSize()       const { return this->pool_size; }
+
+    /** Returns the relative gap to the best placement within which the placements of the pool are collected. */
+    const double&      getPoolGap()        const { return this->pool_gap; }
+
+    /** Returns the number of threads to be used (0 means all available cores). */
+    const int&         getNbThreads()      const { return this->nb_threads; }
+
     /** Returns the output file. */
     const std::string& getOutputFile()     const { return this->output_file; }
 
+    /** Returns the file where the placement of each demand is written (none if empty). */
+    const std::string& getPlacementFile()  const { return this->placement_file; }
+
+	/********************************************/
+	/*				    Setters	    			*/
+	/********************************************/
+    /** Replaces the instance files. @param node The node file. @param link The link file. @param demand The demand file. */
+    void setInstanceFiles(const std::string& node, const std::string& link, const std::string& demand) { node_file = node; link_file = link; demand_file = demand; }
+
 	/********************************************/
 	/*				    Output	    			*/
 	/********************************************/
@@ -0,0 +1,206 @@
+#include "presolve.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+Presolve::Presolve(Data& data_) : data(data_), nbCandidatesBefore(0), nbInfeasibleCandidates(0),
+                nbDominatedCandidates(0), nbRowsBefore(0), nbRedundantRows(0), time(0.0)
+{
+    for (int i = 0; i < data.getNbDemands(); i++){
+        nbCandidatesBefore += data.getCandidates(i).size();
+    }
+    for (int l = 0; l < data.getNbLinks(); l++){
+        if (data.isCapacityActive(l)){
+            nbRowsBefore++;
+        }
+    }
+}
+
+/****************************************************************************************/
+/*										Reductions										*/
+/****************************************************************************************/
+
+/* Removes the candidates that exceed the residual capacity of one of their links. */
+long Presolve::removeInfeasibleCandidates()
+{
+    const int NB_LINKS = data.getNbLinks();
+    long removed = 0;
+    bool changed = true;
+    while (changed){
+        changed = false;
+        /* Demands with a single candidate left consume their throughput on its links. */
+        std::vector<double> residual(NB_LINKS);
+        for (int l = 0; l < NB_LINKS; l++){
+            residual[l] = data.getLink(l).getCapacity();
+        }
+        for (int i = 0; i < data.getNbDemands(); i++){
+            if (data.getCandidates(i).size() == 1){
+                const std::vector<int>& links = data.getCandidates(i)[0].getListOfLinks();
+                for (unsigned int l = 0; l < links.size(); l++){
+                    residual[links[l]] -= data.getDemand(i).getThroughput();
+                }
+            }
+        }
+        for (int i = 0; i < data.getNbDemands(); i++){
+            const std::vector<Candidate>& candidates = data.getCandidates(i);
+            if (candidates.empty()){
+                continue;
+            }
+            double throughput = data.getDemand(i).getThroughput();
+            /* A demand with a single candidate is already counted in the residual capacities. */
+            double own = (candidates.size() == 1) ? throughput : 0.0;
+            std::vector<Candidate> kept;
+            for (unsigned int c = 0; c < candidates.size(); c++){
+                bool fits = true;
+                const std::vector<int>& links = candidates[c].getListOfLinks();
+                for (unsigned int l = 0; l < links.size() && fits; l++){
+                    double capacity = data.getLink(links[l]).getCapacity();
+                    if (throughput > residual[links[l]] + own + PRESOLVE_TOLERANCE*capacity){
+                        fits = false;
+                    }
+                }
+                if (fits){
+                    kept.push_back(candidates[c]);
+                }
+            }
+            if (kept.size() < candidates.size()){
+                removed += candidates.size() - kept.size();
+                /* A demand that becomes fixed or empty changes the residual capacities. */
+                if (kept.size() <= 1){
+                    changed = true;
+                }
+                data.setCandidates(i, kept);
+            }
+        }
+    }
+    return removed;
+}
+
+/* Removes the candidates dominated by another candidate of the same demand. */
+long Presolve::removeDominatedCandidates()
+{
+    long removed = 0;
+    for (int i = 0; i < data.getNbDemands(); i++){
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        const int NB_CANDIDATES = candidates.size();
+        /* Candidates are scanned by increasing cost, then by increasing number of links. */
+        std::vector<int> order(NB_CANDIDATES);
+        std::vector<std::vector<int> > links(NB_CANDIDATES);
+        for (int c = 0; c < NB_CANDIDATES; c++){
+            order[c] = c;
+            links[c] = candidates[c].getListOfLinks();
+            std::sort(links[c].begin(), links[c].end());
+        }
+        std::sort(order.begin(), order.end(), [&](const int a, const int b){
+            if (candidates[a].getCost() != candidates[b].getCost()){
+                return candidates[a].getCost() < candidates[b].getCost();
+            }
+            if (links[a].size() != links[b].size()){
+                return links[a].size() < links[b].size();
+            }
+            return a < b;
+        });
+        /* A candidate is dominated by a kept one that costs no more and uses a subset of its links. */
+        /* Exact ties (same cost, same links) are interchangeable: they are kept only when symmetry breaking handles them, and removed otherwise. */
+        const bool keepTies = data.getInput().isSymmetryBreaking();
+        std::vector<int> keptOrder;
+        std::vector<bool> dominated(NB_CANDIDATES, false);
+        for (int o = 0; o < NB_CANDIDATES; o++){
+            int c = order[o];
+            for (unsigned int k = 0; k < keptOrder.size() && !dominated[c]; k++){
+                int d = keptOrder[k];
+                bool tie = (keepTies && candidates[d].getCost() == candidates[c].getCost() && links[d] == links[c]);
+                if (!tie && std::includes(links[c].begin(), links[c].end(), links[d].begin(), links[d].end())){
+                    dominated[c] = true;
+                }
+            }
+            if (!dominated[c]){
+                keptOrder.push_back(c);
+            }
+        }
+        if ((int)keptOrder.size() < NB_CANDIDATES){
+            std::vector<Candidate> kept;
+            for (int c = 0; c < NB_CANDIDATES; c++){
+                if (!dominated[c]){
+                    kept.push_back(candidates[c]);
+                }
+            }
+            removed += NB_CANDIDATES - kept.size();
+            data.setCandidates(i, kept);
+        }
+    }
+    return removed;
+}
+
+/* Deactivates the capacity rows that can never bind. */
+int Presolve::removeRedundantCapacityRows()
+{
+    const int NB_LINKS = data.getNbLinks();
+    /* Each demand uses a link at most once, whatever candidate it picks. */
+    std::vector<double> potential(NB_LINKS, 0.0);
+    std::vector<int> lastSeen(NB_LINKS, -1);
+    for (int i = 0; i < data.getNbDemands(); i++){
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            const std::vector<int>& links = candidates[c].getListOfLinks();
+            for (unsigned int l = 0; l < links.size(); l++){
+                if (lastSeen[links[l]] != i){
+                    lastSeen[links[l]] = i;
+                    potential[links[l]] += data.getDemand(i).getThroughput();
+                }
+            }
+        }
+    }
+    int removed = 0;
+    for (int l = 0; l < NB_LINKS; l++){
+        double capacity = data.getLink(l).getCapacity();
+        if (data.isCapacityActive(l) && potential[l] <= capacity*(1.0 + PRESOLVE_TOLERANCE)){
+            data.setCapacityActive(l, false);
+            removed++;
+        }
+    }
+    return removed;
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Applies every reduction. */
+void Presolve::run()
+{
+    std::cout << "=> Presolving ..." << std::endl;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    /* Removing dominated candidates may fix demands, which in turn reduces residual capacities. */
+    long dominated = 0;
+    do {
+        nbInfeasibleCandidates += removeInfeasibleCandidates();
+        dominated = removeDominatedCandidates();
+        nbDominatedCandidates += dominated;
+    } while (dominated > 0);
+    nbRedundantRows = removeRedundantCapacityRows();
+
+    infeasibleDemands.clear();
+    for (int i = 0; i < data.getNbDemands(); i++){
+        if (data.getCandidates(i).empty()){
+            infeasibleDemands.push_back(i);
+        }
+    }
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* Displays what was removed. */
+void Presolve::print() const
+{
+    long nbCandidatesAfter = nbCandidatesBefore - nbInfeasibleCandidates - nbDominatedCandidates;
+    std::cout << "\t Candidates: " << nbCandidatesBefore << " -> " << nbCandidatesAfter
+              << " (" << nbInfeasibleCandidates << " exceeding a link capacity, " << nbDominatedCandidates << " dominated)" << std::endl;
+    std::cout << "\t Capacity rows: " << nbRowsBefore << " -> " << nbRowsBefore - nbRedundantRows
+              << " (" << nbRedundantRows << " can never bind)" << std::endl;
+    for (unsigned int d = 0; d < infeasibleDemands.size(); d++){
+        std::cout << "\t Demand " << data.getDemand(infeasibleDemands[d]).getName() << " has no feasible placement candidate." << std::endl;
+    }
+    std::cout << "=> Presolve done in " << time << " seconds." << std::endl;
+}
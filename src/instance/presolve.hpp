@@ -0,0 +1,91 @@
+#ifndef __presolve__hpp
+#define __presolve__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <chrono>
+
+/*** Own Libraries ***/
+#include "data.hpp"
+
+/****************************************************************************************/
+/*										CONSTANTS										*/
+/****************************************************************************************/
+#define PRESOLVE_TOLERANCE 	1e-10 		// Relative tolerance used when comparing throughputs against link capacities
+
+
+/********************************************************************************************
+ * This class applies problem-specific reductions on the placement candidates stored in
+ * Data before any model is built:
+ *  - candidates using a link whose capacity (minus the throughput of the demands that have
+ *    a single candidate left on it) is below the demand throughput are removed, until a
+ *    fixed point is reached;
+ *  - candidates dominated by a candidate of the same demand with smaller or equal cost and
+ *    a subset of its links are removed (exact ties are kept only under symmetry breaking);
+ *  - capacity rows that can never bind, because the total throughput of the demands that
+ *    may use the link fits its capacity, are deactivated.
+ * Demands left without any candidate make the instance infeasible and are reported.
+********************************************************************************************/
+class Presolve
+{
+	private:
+		Data&     				data;   				/**< Data read in data.hpp **/
+
+		/*** Statistics ***/
+		long 					nbCandidatesBefore;		/**< Number of candidates before presolve. **/
+		long 					nbInfeasibleCandidates;	/**< Number of candidates removed for exceeding a link capacity. **/
+		long 					nbDominatedCandidates;	/**< Number of candidates removed for being dominated. **/
+		int 					nbRowsBefore;			/**< Number of capacity rows before presolve. **/
+		int 					nbRedundantRows;		/**< Number of capacity rows that can never bind. **/
+		std::vector<int> 		infeasibleDemands;		/**< Demands left without any candidate. **/
+		double 					time;					/**< Time (in seconds) spent on presolve. **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. @param data The data whose candidates are reduced. **/
+		Presolve(Data& data);
+		Presolve(const Data&&) = delete;
+		Presolve() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns true if presolve proved the instance infeasible. **/
+		bool isInfeasible() const { return !infeasibleDemands.empty(); }
+
+		/** Returns the demands left without any candidate. **/
+		const std::vector<int>& getInfeasibleDemands() const { return infeasibleDemands; }
+
+		/** Returns the time (in seconds) spent on presolve. **/
+		const double& getTime() const { return time; }
+
+	/****************************************************************************************/
+	/*										Reductions										*/
+	/****************************************************************************************/
+		/** Removes the candidates that exceed the residual capacity of one of their links. Returns the number of candidates removed. **/
+		long removeInfeasibleCandidates();
+
+		/** Removes the candidates dominated by another candidate of the same demand. Returns the number of candidates removed. **/
+		long removeDominatedCandidates();
+
+		/** Deactivates the capacity rows that can never bind. Returns the number of rows deactivated. **/
+		int removeRedundantCapacityRows();
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Applies every reduction. **/
+		void run();
+
+		/** Displays what was removed. **/
+		void print() const;
+};
+
+
+#endif
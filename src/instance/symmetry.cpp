@@ -0,0 +1,126 @@
+#include "symmetry.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+Symmetry::Symmetry(const Data& data_) : data(data_)
+{
+    const long NB_NODES = data.getNbNodes();
+    candidateKeys.resize(data.getNbDemands());
+    touching.resize(NB_NODES);
+    for (int i = 0; i < data.getNbDemands(); i++){
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            candidateKeys[i].insert(candidates[c].getDU()*NB_NODES + candidates[c].getCU());
+            touching[candidates[c].getDU()].push_back(std::make_pair(i, (int)c));
+            if (candidates[c].getCU() != candidates[c].getDU()){
+                touching[candidates[c].getCU()].push_back(std::make_pair(i, (int)c));
+            }
+        }
+    }
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Checks if swapping nodes u and v maps the network and the candidates onto themselves. */
+bool Symmetry::isInterchangeable(const int u, const int v) const
+{
+    /* Links incident to u or v must be mapped onto links of same capacity and status. */
+    std::vector<std::tuple<int, int, double, bool> > original, mapped;
+    const int ends[2] = {u, v};
+    for (int e = 0; e < 2; e++){
+        Graph::Node node = data.getGraph().nodeFromId(ends[e]);
+        std::vector<Arc> arcs;
+        for (Graph::OutArcIt a(data.getGraph(), node); a != lemon::INVALID; ++a){
+            arcs.push_back(a);
+        }
+        for (Graph::InArcIt a(data.getGraph(), node); a != lemon::INVALID; ++a){
+            arcs.push_back(a);
+        }
+        for (unsigned int a = 0; a < arcs.size(); a++){
+            int l = data.getArcId(arcs[a]);
+            int s = data.getNodeId(data.getGraph().source(arcs[a]));
+            int t = data.getNodeId(data.getGraph().target(arcs[a]));
+            double capacity = data.getLink(l).getCapacity();
+            original.push_back(std::make_tuple(s, t, capacity, data.isCapacityActive(l)));
+            mapped.push_back(std::make_tuple(swap(s, u, v), swap(t, u, v), capacity, data.isCapacityActive(l)));
+        }
+    }
+    std::sort(original.begin(), original.end());
+    std::sort(mapped.begin(), mapped.end());
+    if (original != mapped){
+        return false;
+    }
+
+    /* Every candidate placing a unit on u or v must have its image among the candidates of the same demand. */
+    const long NB_NODES = data.getNbNodes();
+    if (touching[u].size() != touching[v].size()){
+        return false;
+    }
+    for (int e = 0; e < 2; e++){
+        const std::vector<std::pair<int, int> >& pairs = touching[ends[e]];
+        for (unsigned int p = 0; p < pairs.size(); p++){
+            const Candidate& candidate = data.getCandidates(pairs[p].first)[pairs[p].second];
+            long key = swap(candidate.getDU(), u, v)*NB_NODES + swap(candidate.getCU(), u, v);
+            if (candidateKeys[pairs[p].first].count(key) == 0){
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* Detects the orbits of interchangeable nodes. */
+void Symmetry::run()
+{
+    std::cout << "=> Detecting symmetries ..." << std::endl;
+    orbits.clear();
+
+    /* Swaps are only tried among nodes with the same type and costs that are not demand sources. */
+    std::vector<bool> isSource(data.getNbNodes(), false);
+    for (int i = 0; i < data.getNbDemands(); i++){
+        isSource[data.getDemand(i).getSource()] = true;
+    }
+    std::map<std::tuple<std::string, double, double>, std::vector<std::vector<int> > > groups;
+    for (int j = 0; j < data.getNbNodes(); j++){
+        if (isSource[j]){
+            continue;
+        }
+        const Node& node = data.getNode(j);
+        std::vector<std::vector<int> >& classes = groups[std::make_tuple(node.getType(), node.getCostDU(), node.getCostCU())];
+        /* Interchangeability is an equivalence relation: comparing with a representative is enough. */
+        bool found = false;
+        for (unsigned int c = 0; c < classes.size() && !found; c++){
+            if (isInterchangeable(classes[c][0], j)){
+                classes[c].push_back(j);
+                found = true;
+            }
+        }
+        if (!found){
+            classes.push_back(std::vector<int>(1, j));
+        }
+    }
+    for (std::map<std::tuple<std::string, double, double>, std::vector<std::vector<int> > >::const_iterator it = groups.begin(); it != groups.end(); ++it){
+        for (unsigned int c = 0; c < it->second.size(); c++){
+            if (it->second[c].size() > 1){
+                orbits.push_back(it->second[c]);
+            }
+        }
+    }
+}
+
+/* Displays the orbits found. */
+void Symmetry::print() const
+{
+    std::cout << "\t " << orbits.size() << " orbit(s) of interchangeable nodes found." << std::endl;
+    for (unsigned int o = 0; o < orbits.size(); o++){
+        std::cout << "\t Orbit " << o + 1 << ": ";
+        for (unsigned int n = 0; n < orbits[o].size(); n++){
+            std::cout << data.getNode(orbits[o][n]).getName() << (n + 1 < orbits[o].size() ? ", " : "");
+        }
+        std::cout << std::endl;
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef __symmetry__hpp
+#define __symmetry__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <map>
+#include <tuple>
+#include <unordered_set>
+
+/*** Own Libraries ***/
+#include "data.hpp"
+
+
+/********************************************************************************************
+ * This class detects orbits of interchangeable nodes: nodes of the same type and costs
+ * such that swapping any two of them maps the network (links, capacities and active
+ * capacity rows) and the placement candidates of every demand onto themselves. Swapping
+ * two nodes of an orbit maps any placement onto a placement of same cost, so the group
+ * acting on an orbit is the full symmetric group. Nodes that are the source of some
+ * demand are never part of an orbit, so that demands are left unchanged by the swaps.
+********************************************************************************************/
+class Symmetry
+{
+	private:
+		const Data&     						data;   		/**< Data read in data.hpp **/
+		std::vector<std::unordered_set<long> > 	candidateKeys;	/**< The (DU,CU) pairs of the candidates of each demand. **/
+		std::vector<std::vector<std::pair<int, int> > > touching;	/**< The (demand, candidate) pairs placing a DU or a CU on each node. **/
+		std::vector<std::vector<int> > 			orbits;			/**< Orbits of interchangeable nodes (at least two nodes each, sorted by id). **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. @param data The data whose nodes are analysed. **/
+		Symmetry(const Data& data);
+		Symmetry(const Data&&) = delete;
+		Symmetry() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns the orbits of interchangeable nodes. **/
+		const std::vector<std::vector<int> >& getOrbits() const { return orbits; }
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Returns the image of node w by the transposition of nodes u and v. **/
+		int swap(const int w, const int u, const int v) const { return (w == u) ? v : ((w == v) ? u : w); }
+
+		/** Checks if swapping nodes u and v maps the network and the candidates onto themselves. **/
+		bool isInterchangeable(const int u, const int v) const;
+
+		/** Detects the orbits of interchangeable nodes. **/
+		void run();
+
+		/** Displays the orbits found. **/
+		void print() const;
+};
+
+
+#endif
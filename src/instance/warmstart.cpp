@@ -0,0 +1,188 @@
+#include "warmstart.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+WarmStart::WarmStart(const Data& data_) : data(data_), cost(0.0), nbKept(0), nbRepaired(0), nbNew(0), nbUnplaced(0)
+{
+    networkHash = hashNetwork();
+    std::string directory = data.getInput().getWarmStartDir();
+    if (!directory.empty()){
+        if (directory.back() != '/'){
+            directory += "/";
+        }
+        file = directory + networkHash + ".csv";
+    }
+    placement.assign(data.getNbDemands(), -1);
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Computes the hash of the network (64-bit FNV-1a over its description). */
+std::string WarmStart::hashNetwork() const
+{
+    std::ostringstream description;
+    description << std::setprecision(17);
+    for (int v = 0; v < data.getNbNodes(); v++){
+        const Node& node = data.getNode(v);
+        description << node.getName() << ";" << node.getType() << ";" << node.getCostCU() << ";" << node.getCostDU() << ";\n";
+    }
+    for (int l = 0; l < data.getNbLinks(); l++){
+        const Link& link = data.getLink(l);
+        description << link.getName() << ";" << data.getNode(link.getSource()).getName() << ";"
+                    << data.getNode(link.getTarget()).getName() << ";" << link.getCapacity() << ";\n";
+    }
+
+    uint64_t hash = 14695981039346656037ULL;
+    const std::string text = description.str();
+    for (unsigned int k = 0; k < text.size(); k++){
+        hash ^= (unsigned char)text[k];
+        hash *= 1099511628211ULL;
+    }
+    std::ostringstream hex;
+    hex << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return hex.str();
+}
+
+/* Reads the stored placements of this network, if any. */
+void WarmStart::load()
+{
+    stored.clear();
+    if (file.empty()){
+        return;
+    }
+    std::cout << "=> Reading warm-start store " << file << " ..." << std::endl;
+    std::ifstream probe(file.c_str());
+    if (!probe.is_open()){
+        std::cout << "\t No placement stored for this network yet." << std::endl;
+        return;
+    }
+    probe.close();
+
+    Reader reader(file);
+    std::vector<std::vector<std::string> > dataList = reader.getData();
+    // Skip the header line
+    for (unsigned int row = 1; row < dataList.size(); row++){
+        if (dataList[row].size() < 3){
+            continue;
+        }
+        stored[dataList[row][0]] = std::make_pair(dataList[row][1], dataList[row][2]);
+    }
+    std::cout << "\t " << stored.size() << " stored placement(s) found." << std::endl;
+}
+
+/* Maps the stored placements onto the current candidates and repairs the others. */
+void WarmStart::repair()
+{
+    const int NB_DEMANDS = data.getNbDemands();
+    placement.assign(NB_DEMANDS, -1);
+    cost = 0.0;
+    nbKept = nbRepaired = nbNew = nbUnplaced = 0;
+    if (stored.empty()){
+        return;
+    }
+
+    std::vector<double> residual(data.getNbLinks());
+    for (unsigned int l = 0; l < residual.size(); l++){
+        residual[l] = data.getLink(l).getCapacity();
+    }
+    std::function<bool(int, int)> fits = [&](int i, int c){
+        const std::vector<int>& links = data.getCandidates(i)[c].getListOfLinks();
+        double lambda = data.getDemand(i).getThroughput();
+        for (unsigned int l = 0; l < links.size(); l++){
+            if (lambda > residual[links[l]] + WARMSTART_CAPACITY_TOLERANCE*data.getLink(links[l]).getCapacity()){
+                return false;
+            }
+        }
+        return true;
+    };
+    std::function<void(int, int)> assign = [&](int i, int c){
+        const Candidate& candidate = data.getCandidates(i)[c];
+        for (unsigned int l = 0; l < candidate.getListOfLinks().size(); l++){
+            residual[candidate.getListOfLinks()[l]] -= data.getDemand(i).getThroughput();
+        }
+        placement[i] = c;
+        cost += candidate.getCost();
+    };
+
+    /* Stored placements are kept when their candidate still exists and fits. */
+    std::vector<int> pending;
+    for (int i = 0; i < NB_DEMANDS; i++){
+        auto search = stored.find(data.getDemand(i).getName());
+        if (search == stored.end()){
+            nbNew++;
+            pending.push_back(i);
+            continue;
+        }
+        int du = data.getIdFromNodeName(search->second.first);
+        int cu = data.getIdFromNodeName(search->second.second);
+        int c = data.getCandidateIndex(i, du, cu);
+        if (c >= 0 && fits(i, c)){
+            assign(i, c);
+            nbKept++;
+        }
+        else{
+            nbRepaired++;
+            pending.push_back(i);
+        }
+    }
+
+    /* The remaining demands take their cheapest candidate that fits, largest throughput first. */
+    std::stable_sort(pending.begin(), pending.end(), [&](int a, int b){
+        return data.getDemand(a).getThroughput() > data.getDemand(b).getThroughput();
+    });
+    for (unsigned int p = 0; p < pending.size(); p++){
+        int i = pending[p];
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        int best = -1;
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            if (fits(i, c) && (best < 0 || candidates[c].getCost() < candidates[best].getCost())){
+                best = c;
+            }
+        }
+        if (best >= 0){
+            assign(i, best);
+        }
+        else{
+            nbUnplaced++;
+        }
+    }
+}
+
+/* Writes the given placement to the store. */
+void WarmStart::save(const std::vector<int>& solution) const
+{
+    if (file.empty()){
+        return;
+    }
+    std::ofstream store(file.c_str(), std::ios_base::trunc);
+    if (!store){
+        std::cout << "WARNING: Unable to write warm-start store '" << file << "'." << std::endl;
+        return;
+    }
+    store << "demand;du;cu;" << std::endl;
+    for (int i = 0; i < data.getNbDemands(); i++){
+        if (solution[i] < 0){
+            continue;
+        }
+        const Candidate& candidate = data.getCandidates(i)[solution[i]];
+        store << data.getDemand(i).getName() << ";" << data.getNode(candidate.getDU()).getName() << ";"
+              << data.getNode(candidate.getCU()).getName() << ";" << std::endl;
+    }
+    store.close();
+    std::cout << "=> Placement saved to warm-start store " << file << "." << std::endl;
+}
+
+/* Displays what was kept and repaired. */
+void WarmStart::print() const
+{
+    if (stored.empty()){
+        return;
+    }
+    std::cout << "\t " << nbKept << " placement(s) kept, " << nbRepaired << " repaired, " << nbNew << " new demand(s), "
+              << nbUnplaced << " demand(s) left unplaced." << std::endl;
+    std::cout << "\t Warm start " << (isComplete() ? "complete" : "partial") << ", of cost " << cost << "." << std::endl;
+}
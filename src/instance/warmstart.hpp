@@ -0,0 +1,98 @@
+#ifndef __warmstart__hpp
+#define __warmstart__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
+/*** Own Libraries ***/
+#include "data.hpp"
+
+/****************************************************************************************/
+/*										CONSTANTS										*/
+/****************************************************************************************/
+#define WARMSTART_CAPACITY_TOLERANCE 	1e-9 	// Relative tolerance used when checking link capacities
+
+
+/********************************************************************************************
+ * This class keeps the placements of previous runs on disk so that recurring instances do
+ * not start from nothing. The final placement of each demand is stored by name, as a pair
+ * (DU name, CU name), in a file named after a hash of the network (nodes, costs, links and
+ * capacities) inside the warm-start directory. On the next run over the same network, the
+ * stored pairs are mapped onto the candidates of the current Data by name. Stored
+ * placements that no longer exist or no longer fit the link capacities, as well as new
+ * demands, are repaired greedily with the cheapest candidate that fits. The result is
+ * meant to be installed as a MIP start (or as the first incumbent of the branch-and-bound).
+********************************************************************************************/
+class WarmStart
+{
+	private:
+		const Data&     						data;   		/**< Data read in data.hpp **/
+		std::string 							networkHash;	/**< Hash of the network, in hexadecimal. **/
+		std::string 							file;			/**< File of the store for this network (empty if disabled). **/
+		std::unordered_map<std::string, std::pair<std::string, std::string> > stored;	/**< Stored (DU name, CU name) of each demand name. **/
+		std::vector<int> 						placement;		/**< Chosen candidate of each demand in the start (-1 if none). **/
+		double 									cost;			/**< Cost of the start. **/
+		int 									nbKept;			/**< Number of stored placements kept as they are. **/
+		int 									nbRepaired;		/**< Number of stored placements that had to be replaced. **/
+		int 									nbNew;			/**< Number of demands without stored placement. **/
+		int 									nbUnplaced;		/**< Number of demands left without placement. **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. Hashes the network and locates the store file. @param data The data of the current run. **/
+		WarmStart(const Data& data);
+		WarmStart(const Data&&) = delete;
+		WarmStart() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns the hash of the network, in hexadecimal. **/
+		const std::string& getNetworkHash() const { return networkHash; }
+
+		/** Returns the file of the store for this network. **/
+		const std::string& getFile() const { return file; }
+
+		/** Returns true if some placement was found in the store. **/
+		bool isFound() const { return !stored.empty(); }
+
+		/** Returns the chosen candidate of each demand in the start (-1 if none). **/
+		const std::vector<int>& getPlacement() const { return placement; }
+
+		/** Returns true if every demand is placed in the start. **/
+		bool isComplete() const { return (nbUnplaced == 0); }
+
+		/** Returns the cost of the start. **/
+		double getCost() const { return cost; }
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Computes the hash of the network: nodes, costs, links and capacities, in file order. **/
+		std::string hashNetwork() const;
+
+		/** Reads the stored placements of this network, if any. **/
+		void load();
+
+		/** Maps the stored placements onto the current candidates and repairs the ones that are missing or do not fit. **/
+		void repair();
+
+		/** Writes the given placement (chosen candidate of each demand, -1 if none) to the store. **/
+		void save(const std::vector<int>& solution) const;
+
+		/** Displays what was kept and repaired. **/
+		void print() const;
+};
+
+
+#endif
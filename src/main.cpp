@@ -3,16 +3,235 @@ ILOSTLBEGIN
 
 #include "tools/others.hpp"
 #include "instance/data.hpp"
+#include "instance/presolve.hpp"
+#include "instance/feasibility.hpp"
+#include "instance/warmstart.hpp"
 #include "solver/model.hpp"
+#include "solver/branchandbound.hpp"
+#include "solver/firstorder.hpp"
+#include "solver/diving.hpp"
+#include "solver/decomposition.hpp"
+#include "solver/bulkmodel.hpp"
+#include "solver/portfolio.hpp"
+#include "solver/tuning.hpp"
+#include "solver/pareto.hpp"
+#include "solver/robust.hpp"
+#include "solver/online.hpp"
+#include "solver/rolling.hpp"
 
 int main(int argc, char *argv[]) {
     greetingMessage();
     std::string parameterFile = getParameter(argc, argv);
 
+    Input input(parameterFile);
+
+    /* Tuning mode: Cplex parameters are tuned over a directory of instances and saved */
+    if (!input.getTuningDir().empty()){
+        Tuning tuning(input);
+        tuning.run();
+        return 0;
+    }
+
     /* Build data */
-    Data data(parameterFile);
+    Data data(input);
     data.print();
 
+    /* Online mode: demands of the trace are admitted one at a time, the candidate index replaces presolve */
+    if (!data.getInput().getOnlineTrace().empty()){
+        Online online(data);
+        online.run();
+        online.printResult();
+        online.output();
+        data.setPlacement(online.getPlacement());
+        data.writePlacementFile();
+        return 0;
+    }
+
+    /* Simple certificates of infeasibility: an infeasible instance is rejected before any model is built */
+    Feasibility feasibility(data);
+    feasibility.run();
+    feasibility.print();
+    if (feasibility.isInfeasible()){
+        return 0;
+    }
+
+    /* Problem-specific reductions on the placement candidates: they rely on the nominal throughputs, so not under scenarios or periods */
+    if (data.getInput().isPresolve() && (data.getNbScenarios() > 0 || data.getNbPeriods() > 0)){
+        std::cout << "=> Presolve is skipped under throughput scenarios or periods." << std::endl;
+    }
+    else if (data.getInput().isPresolve()){
+        Presolve presolve(data);
+        presolve.run();
+        presolve.print();
+        if (presolve.isInfeasible()){
+            std::cout << "=> The instance is infeasible." << std::endl;
+            return 0;
+        }
+    }
+
+    /* Placements of previous runs over the same network, repaired for the current demands */
+    WarmStart warmStart(data);
+    bool useWarmStart = (!data.getInput().getWarmStartDir().empty() && !data.getInput().isRelaxation());
+    if (useWarmStart){
+        warmStart.load();
+        warmStart.repair();
+        warmStart.print();
+    }
+    bool hasStart = (useWarmStart && warmStart.isFound());
+    std::vector<int> start = (hasStart ? warmStart.getPlacement() : std::vector<int>());
+
+    /* A placement found by a solver is stored in the demands, written to the placement file and kept for the next runs */
+    bool integral = !data.getInput().isRelaxation();
+    std::function<void(const std::vector<int>&)> storePlacement = [&](const std::vector<int>& placement){
+        data.setPlacement(placement);
+        data.writePlacementFile();
+        if (useWarmStart){
+            warmStart.save(placement);
+        }
+    };
+
+    /* LP-guided dives: the relaxation is solved once and rounded on several threads, into a start or, for a relaxation run, into the answer.
+       Input rejects them under scenarios or periods, whose modes take no start. */
+    if (data.getInput().getNbDives() > 0){
+        Diving diving(data);
+        diving.run();
+        if (!integral){
+            diving.printResult();
+            diving.output();
+            if (diving.hasSolution()){
+                storePlacement(diving.getPlacement());
+            }
+            return 0;
+        }
+        if (diving.hasSolution() && (!hasStart || !warmStart.isComplete() || diving.getCost() < warmStart.getCost())){
+            start = diving.getPlacement();
+            hasStart = true;
+        }
+    }
+
+    /* Throughput scenarios: capacity rows are generated per scenario until the placement satisfies the required ones */
+    if (data.getNbScenarios() > 0){
+        Robust robust(data);
+        robust.run();
+        robust.printResult();
+        robust.output();
+        if (robust.hasSolution()){
+            storePlacement(robust.getPlacement());
+        }
+        return 0;
+    }
+
+    /* Multi-period planning: windows of consecutive periods are solved on one model, committing a period at a time */
+    if (data.getNbPeriods() > 0){
+        IloEnv env;
+        try
+        {
+            RollingHorizon rolling(env, data);
+            rolling.run();
+            rolling.printResult();
+            rolling.output();
+        }
+        catch (const IloException& e) { env.end(); std::cerr << "Exception caught: " << e << std::endl; return 1; }
+        catch (...) { env.end(); std::cerr << "Unknown exception caught!" << std::endl; return 1; }
+        env.end();
+        return 0;
+    }
+
+    /* Combinatorial branch-and-bound: runs on Data directly, without CPLEX */
+    if (data.getInput().getSolver() == "bb"){
+        BranchAndBound bb(data);
+        if (hasStart){
+            bb.setInitialPlacement(start);
+        }
+        bb.run();
+        bb.printResult();
+        bb.output();
+        if (bb.hasSolution()){
+            storePlacement(bb.getPlacement());
+        }
+        return 0;
+    }
+
+    /* Cost versus peak utilization frontier: the utilization variable couples every link, so it comes before decomposition */
+    if (integral && data.getInput().getParetoPoints() > 0){
+        Pareto pareto(data);
+        pareto.run();
+        pareto.printResult();
+        pareto.output();
+        return 0;
+    }
+
+    /* Independent components are solved as separate models, each one built through Concert */
+    bool decompose = (!data.getInput().isRelaxation() && data.getInput().isDecomposition() && data.getInput().getPoolSize() == 0);
+    if (decompose && data.getInput().getBuild() == "bulk"){
+        std::cout << "=> Decomposition is skipped with the bulk build." << std::endl;
+        decompose = false;
+    }
+    if (decompose && !data.getInput().getPortfolioFile().empty()){
+        std::cout << "=> Decomposition is skipped with a portfolio: the configurations race on the whole instance." << std::endl;
+        decompose = false;
+    }
+    if (decompose){
+        Decomposition decomposition(data);
+        if (decomposition.getNbComponents() > 1){
+            if (hasStart){
+                decomposition.setMipStart(start);
+            }
+            decomposition.run();
+            decomposition.printResult();
+            decomposition.output();
+            IloAlgorithm::Status status = decomposition.getStatus();
+            if (status == IloAlgorithm::Optimal || status == IloAlgorithm::Feasible){
+                storePlacement(decomposition.getPlacement());
+            }
+            return 0;
+        }
+    }
+
+    /* Differently configured solves run concurrently, the first proof of optimality stops the others */
+    if (integral && !data.getInput().getPortfolioFile().empty()){
+        Portfolio portfolio(data);
+        if (hasStart){
+            portfolio.setMipStart(start);
+        }
+        portfolio.run();
+        portfolio.printResult();
+        portfolio.output();
+        if (portfolio.getWinner() >= 0){
+            storePlacement(portfolio.getPlacement());
+        }
+        return 0;
+    }
+
+    /* Linear relaxation through the native first-order solver */
+    bool nativeRelaxation = (data.getInput().isRelaxation() && data.getInput().getLpSolver() == "native");
+    double nativeBound = 0.0;
+    if (nativeRelaxation){
+        FirstOrderSolver lp(data);
+        lp.run();
+        lp.printResult();
+        lp.output();
+        if (!data.getInput().isLpCheck()){
+            return 0;
+        }
+        nativeBound = lp.getLowerBound();
+    }
+
+    /* Model assembled in flat arrays and loaded through the callable library */
+    if (data.getInput().getBuild() == "bulk" && !nativeRelaxation){
+        BulkModel model(data);
+        if (hasStart){
+            model.setMipStart(start);
+        }
+        model.run();
+        model.printResult();
+        model.output();
+        if (integral && model.isSolutionAvailable()){
+            storePlacement(model.getPlacement());
+        }
+        return 0;
+    }
+
     /* Build cplex environment */
     IloEnv env;
 	
@@ -20,13 +239,35 @@ int main(int argc, char *argv[]) {
     {
         /* Build model */
         Model model(env, data);
+        if (hasStart){
+            model.setMipStart(start);
+        }
 
         /* Run model */
         model.run();
 
+        /* Exactness check of the native relaxation */
+        if (nativeRelaxation){
+            double cplexValue = model.getObjValue();
+            std::cout << "=> LP check: native bound " << nativeBound << ", CPLEX value " << cplexValue 
+                      << ", relative difference " << std::fabs(nativeBound - cplexValue) / std::max(1.0, std::fabs(cplexValue)) << std::endl;
+            env.end();
+            return 0;
+        }
+
         /* Print results */
         model.printResult();
         model.output();
+
+        /* Alternatives of the solution pool, cheapest first, each in its own placement file */
+        for (unsigned int r = 0; r < model.getPool().size() && !data.getInput().getPlacementFile().empty(); r++){
+            data.setPlacement(model.getPool()[r]);
+            data.writePlacementFile(insertSuffix(data.getInput().getPlacementFile(), "_" + std::to_string(r + 1)));
+        }
+        model.outputPool();
+        if (integral && model.isSolutionAvailable()){
+            storePlacement(model.getPlacement());
+        }
     }
     catch (const IloException& e) { env.end(); std::cerr << "Exception caught: " << e << std::endl; return 1; }
     catch (...) { env.end(); std::cerr << "Unknown exception caught!" << std::endl; return 1; }
@@ -0,0 +1,24 @@
+#include "candidate.hpp"
+
+/****************************************************************************************/
+/*										Constructor										*/
+/****************************************************************************************/
+
+/** Constructor. **/
+Candidate::Candidate(const int du, const int cu, const double c, const std::vector<int> &links) : 
+            du_id(du), cu_id(cu), cost(c), link_list(links) {}
+
+/****************************************************************************************/
+/*										Display											*/
+/****************************************************************************************/
+/* Displays information about the candidate. */
+void Candidate::print() const{
+    std::cout << "DU: " << du_id << ", "
+              << "CU: " << cu_id << ", "
+              << "Cost: " << cost << ", "
+              << "Links: ";
+    for (unsigned int l = 0; l < link_list.size(); l++){
+        std::cout << link_list[l] << " ";
+    }
+    std::cout << std::endl;
+}
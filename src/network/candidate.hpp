@@ -0,0 +1,52 @@
+#ifndef __candidate__hpp
+#define __candidate__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <iostream>
+#include <string>
+#include <vector>
+
+
+/****************************************************************************************
+ * This class models a placement candidate of a demand, that is, a feasible (DU,CU) pair.
+ * Each candidate has the node hosting the DU, the node hosting the CU, the placement cost
+ * and the list of links whose capacity is consumed by the demand when placed this way.
+****************************************************************************************/
+class Candidate{
+    private:
+        int 				du_id;			/**< Id of the node hosting the DU. **/
+        int 				cu_id;			/**< Id of the node hosting the CU. **/
+        double 				cost;			/**< Placement cost (DU cost + CU cost). **/
+        std::vector<int> 	link_list;		/**< List of the ids of links whose capacity is consumed. **/
+
+    public:
+	/****************************************************************************************/
+	/*										Constructor										*/
+	/****************************************************************************************/
+	/** Constructor. @param du DU node id. @param cu CU node id. @param c Placement cost. @param links Ids of the links whose capacity is consumed. **/
+	Candidate(const int du = -1, const int cu = -1, const double c = 0.0, const std::vector<int> &links = std::vector<int>());
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+	/** Returns the id of the node hosting the DU. **/
+	const int& 					getDU() 		const { return this->du_id; }
+	/** Returns the id of the node hosting the CU. **/
+	const int& 					getCU() 		const { return this->cu_id; }
+	/** Returns the placement cost. **/
+	const double& 				getCost() 		const { return this->cost; }
+	/** Returns the list of the ids of links whose capacity is consumed. **/
+	const std::vector<int>& 	getListOfLinks() const { return this->link_list; }
+
+	/****************************************************************************************/
+	/*										Display											*/
+	/****************************************************************************************/
+	/** Displays information about the candidate. **/
+	void print() const;
+};
+
+#endif
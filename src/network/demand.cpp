@@ -4,20 +4,31 @@
 /*										Constructor										*/
 /****************************************************************************************/
 
-/** Constructor. **/
+/** The constructor is inlined: a demand is a view on its row of the network store. **/
 // Demand::Demand(const int i, const std::string n, const int s, const int t, const double l, const double b) : 
 //             id(i), name(n), source(s), target(t), max_latency(l), bandwidth(b) {}
-Demand::Demand(const int i, const std::string n, const int s, const double l, const double t) : 
-            id(i), name(n), source(s), max_latency(l), throughput(t) {}
+/****************************************************************************************/
+/*										Getters											*/
+/****************************************************************************************/
+/* Returns the links of the chosen candidate. */
+const std::vector<int>& Demand::getListOfLinks() const{
+    static const std::vector<int> none;
+    int candidate = getCandidate();
+    if (candidate < 0 || candidates == NULL){
+        return none;
+    }
+    return (*candidates)[id][candidate].getListOfLinks();
+}
+
 /****************************************************************************************/
 /*										Display											*/
 /****************************************************************************************/
 /* Displays information about the demand. */
-void Demand::print(){
+void Demand::print() const{
     std::cout << "Id: " << id << ", "
-              << "Name: " << name << ","
-              << "Source: " << source << ", "
+              << "Name: " << getName() << ","
+              << "Source: " << getSource() << ", "
             //   << "Target: " << target << ","
-              << "Max latency: " << max_latency << ", "
-              << "Bandwidth: " << throughput << std::endl;
+              << "Max latency: " << getMaxLatency() << ", "
+              << "Bandwidth: " << getThroughput() << std::endl;
 }
\ No newline at end of file
@@ -10,20 +10,21 @@
 #include <string>
 #include <vector>
 
+/*** Own Libraries ***/
+#include "store.hpp"
+#include "candidate.hpp"
 
 /****************************************************************************************
  * This class models a demand in the network. Each demand has an id, a name, a source, 
- * a target, a maximum latency and a required bandwidth.
+ * a target, a maximum latency and a required bandwidth. The fields live in the network
+ * store: a demand is a view on its row. The links routing a placed demand are those of its
+ * chosen candidate.
 ****************************************************************************************/
 class Demand{
     private:
-        const int 					id;					/**< Demand id. **/
-        const std::string 			name;				/**< Demand name. **/
-		const int				    source;		        /**< Demand source node id. **/
-		// const int				    target;		        /**< Demand target node id. **/
-		const double        		max_latency;     	/**< Demand maximum latency. **/
-		const double 				throughput;			/**< Demand requested bandwidth. **/
-		std::vector<int>	        link_list;	        /**< List of the ids of links routing the demand. (Output) **/
+        const NetworkStore* 		store;				/**< The store holding the demand's fields. **/
+        const std::vector<std::vector<Candidate> >* candidates;	/**< The placement candidates of every demand. **/
+        int 						id;					/**< Demand id. **/
 
 
     public:
@@ -33,37 +34,41 @@ class Demand{
 
 	// /** Constructor. @param i Demand id. @param n Demand name. @param s Demand source node id. @param t Demand target node id. @param l Demand maximum latency. @param b Demand requested bandwidth. **/
 	// Demand(const int i = -1, const std::string n = "", const int s = -1, const int t = -1, const double l = 0.0, const double b = 0.0);
-	/** Constructor. @param i Demand id. @param n Demand name. @param s Demand source node id. @param l Demand maximum latency. @param t Demand requested bandwidth. **/
-	Demand(const int i = -1, const std::string n = "", const int s = -1, const double l = 0.0, const double t = 0.0);
+	/** Constructor. @param s The store holding the demand's fields. @param c The placement candidates of every demand. @param i Demand id. **/
+	Demand(const NetworkStore* s = NULL, const std::vector<std::vector<Candidate> >* c = NULL, const int i = -1) : store(s), candidates(c), id(i) {}
 
 	/****************************************************************************************/
 	/*										Getters											*/
 	/****************************************************************************************/
     
 	/** Returns the demand's id. **/
-	const int& 					getId()				const { return this->id; }
+	int 						getId()				const { return this->id; }
 	/** Returns the demand's name. **/
-	const std::string& 			getName() 			const { return this->name; }
+	const std::string& 			getName() 			const { return store->names.getName(store->demandName[id]); }
 	/** Returns the demand's source node id. **/
-	const int& 				    getSource() 	    const { return this->source; }
+	int 					    getSource() 	    const { return store->demandSource[id]; }
 	/** Returns the demand's target node id. **/
 	// const int& 				    getTarget() 	    const { return this->target; }
 	// /** Returns the demand's maximum latency. **/
-	const double& 				getMaxLatency() 	const { return this->max_latency; }
+	double 						getMaxLatency() 	const { return store->demandMaxLatency[id]; }
 	/** Returns the demand's requested bandwidth. **/
-	const double& 				getThroughput() 		const { return this->throughput; }
-	/** Returns the list of arcs routing the demand. **/
-	const std::vector<int>& 	getListOfLinks()    const { return this->link_list; }
-	/** Returns the number of number of hops in demand's path. **/
-	const unsigned int 		    getNbHops() 	    const { return this->link_list.size(); }
-
-
+	double 						getThroughput() 		const { return store->demandThroughput[id]; }
+	/** Returns the position of the candidate placing the demand (-1 if not placed); its links route the demand. **/
+	int 					    getCandidate() 	    const { return store->demandCandidate[id]; }
+	/** Returns the id of the node hosting the demand's DU (-1 if not placed). **/
+	int 					    getDU() 		    const { return store->demandDU[id]; }
+	/** Returns the id of the node hosting the demand's CU (-1 if not placed). **/
+	int 					    getCU() 		    const { return store->demandCU[id]; }
+	/** Returns the list of links routing the demand: those of its chosen candidate (empty if not placed). **/
+	const std::vector<int>& 	getListOfLinks()    const;
+	/** Returns the number of hops in the demand's path. **/
+	unsigned int 				getNbHops() 	    const { return getListOfLinks().size(); }
 
 	/****************************************************************************************/
 	/*										Display											*/
 	/****************************************************************************************/
 	/** Displays information about the demand. **/
-	void print();
+	void print() const;
 };
 
 #endif
\ No newline at end of file
@@ -4,21 +4,19 @@
 /*										Constructor										*/
 /****************************************************************************************/
 
-/** Constructor. **/
+/** The constructor is inlined: a link is a view on its row of the network store. **/
 // Link::Link(const int i, const std::string n, const int s, const int t, const double d, const double b) : 
 //                 id(i), name(n), source_id(s), target_id(t), delay(d), bandwidth(b) {}
-Link::Link(const int i, const std::string n, const int s, const int t, const double c) : 
-                id(i), name(n), source_id(s), target_id(t), capacity(c) {}
 /****************************************************************************************/
 /*										Display											*/
 /****************************************************************************************/
 /* Displays information about the link. */
-void Link::print(){
+void Link::print() const{
     std::cout << "Id: " << id << ", "
-              << "Name: " << name << ", "
-              << "Source: " << source_id << ", "
-              << "Target: " << target_id << ", "
-              << "Bandwidth: " << capacity << std::endl;
-            //   << "Delay: " << delay << ", "
+              << "Name: " << getName() << ", "
+              << "Source: " << getSource() << ", "
+              << "Target: " << getTarget() << ", "
+              << "Bandwidth: " << getCapacity() << ", "
+              << "Delay: " << getDelay() << std::endl;
             //   << "Bandwidth: " << bandwidth << std::endl;
 }
\ No newline at end of file
@@ -9,19 +9,19 @@
 #include <iostream>
 #include <string>
 
+/*** Own Libraries ***/
+#include "store.hpp"
 
 /********************************************************
  * This class models a link in the network. 
  * Each link has an id, a name, a source and a target.
+ * The fields live in the network store: a link is a 
+ * view on its row.
 ********************************************************/
 class Link{
     private:
-        const int 	 	  id;			/**< Link id. **/				
-        const std::string name;			/**< Link name. **/
-        const int 		  source_id;	/**< Link source. **/
-        const int 		  target_id;	/**< Link target. **/
-		const double 	  capacity;		/**< Link capacity. **/
-		// const double 	  delay;		/**< Link delay. **/
+        const NetworkStore* store;		/**< The store holding the link's fields. **/
+        int 	 	  	  id;			/**< Link id. **/
 		// const double 	  bandwidth;	/**< Link total bandwidth. **/
 
     public:
@@ -30,24 +30,24 @@ class Link{
 	/****************************************************************************************/
 	// /** Constructor. @param id_ Link id. @param name_ Link name. @param s Link's source id. @param t Link's target id. @param d Link's delay. @param b Link's total bandwidth. **/
 	// Link(const int id_ = -1, const std::string name_ = "", const int s = -1, const int t = -1, const double d = 0.0, const double b = 0.0);
-	/** Constructor. @param id_ Link id. @param name_ Link name. @param s Link's source id. @param t Link's target id. @param c Link's capacity. **/
-	Link(const int id_ = -1, const std::string name_ = "", const int s = -1, const int t = -1, const double c = 0.0);
+	/** Constructor. @param store_ The store holding the link's fields. @param id_ Link id. **/
+	Link(const NetworkStore* store_ = NULL, const int id_ = -1) : store(store_), id(id_) {}
 
 	/****************************************************************************************/
 	/*										Getters											*/
 	/****************************************************************************************/
 	/** Returns the link's id. **/
-	const int& 			getId() 		const { return this->id; }
+	int 				getId() 		const { return this->id; }
 	/** Returns the link's name. **/
-	const std::string& 	getName() 		const { return this->name; }
+	const std::string& 	getName() 		const { return store->names.getName(store->linkName[id]); }
 	/** Returns the link's source id. **/
-	const int& 			getSource() 	const { return this->source_id; }
+	int 				getSource() 	const { return store->linkSource[id]; }
 	/** Returns the link's target id. **/
-	const int& 			getTarget() 	const { return this->target_id; }
+	int 				getTarget() 	const { return store->linkTarget[id]; }
 	/** Returns the link's capacity. **/
-	const double& 		getCapacity() 		const { return this->capacity; }
-	// /** Returns the link's delay. **/
-	// const double& 		getDelay() 		const { return this->delay; }
+	double 				getCapacity() 		const { return store->linkCapacity[id]; }
+	/** Returns the link's propagation delay. **/
+	double 				getDelay() 		const { return store->linkDelay[id]; }
 	// /** Returns the link's total bandwidth. **/
 	// const double& 		getBandwidth() 	const { return this->bandwidth; }
 
@@ -55,7 +55,7 @@ class Link{
 	/*										Display											*/
 	/****************************************************************************************/
 	/** Displays information about the link. **/
-	void print();
+	void print() const;
 };
 
 #endif
\ No newline at end of file
@@ -4,11 +4,9 @@
 /*										Constructor										*/
 /****************************************************************************************/
 
-/** Constructor. **/
+/** The constructor is inlined: a node is a view on its row of the network store. **/
 // Node::Node(const int id_, const std::string name_, const double x, const double y, const double cap, const double cost) : 
 //                 id(id_), name(name_), coordinate_x(x), coordinate_y(y), capacity(cap), unitary_cost(cost) {}
-Node::Node(const int id_, const std::string name_, const std::string type_, const double costCU, const double costDU) : 
-                id(id_), name(name_), type(type_), costCU(costCU), costDU(costDU){}
 /****************************************************************************************/
 /*										Display										    */
 /****************************************************************************************/
@@ -16,8 +14,8 @@ Node::Node(const int id_, const std::string name_, const std::string type_, cons
 /* Displays information about the node. */
 void Node::print() const{
     std::cout << "Id: " << id << ", "
-              << "Name: " << name << ", "
-              << "Type: " << type << ", "
-              << "Cost CU: " << costCU << ", "
-              << "Cost DU: " << costDU << std::endl;
+              << "Name: " << getName() << ", "
+              << "Type: " << getType() << ", "
+              << "Cost CU: " << getCostCU() << ", "
+              << "Cost DU: " << getCostDU() << std::endl;
 }
\ No newline at end of file
@@ -9,18 +9,18 @@
 #include <iostream>
 #include <string>
 
+/*** Own Libraries ***/
+#include "store.hpp"
 
 /*****************************************************************
  * This class models a node in the network. Each node has an id, 
- * a name, (x,y) coordinates, a capacity and an unitary cost.
+ * a name, a type and the costs of deploying a CU and a DU. The
+ * fields live in the network store: a node is a view on its row.
 *****************************************************************/
 class Node{
     private:
-        const int id;					/**< The node's id. **/
-        const std::string name;			/**< The node's name. **/
-		const std::string type;			/**< The node's type. **/
-        const double costCU;			/**< The node's cost to deploy a CU. **/
-        const double costDU;			/**< The node's cost to deploy a DU **/
+        const NetworkStore* store;		/**< The store holding the node's fields. **/
+        int id;							/**< The node's id. **/
         // const double coordinate_x;		/**< The node's x coordinate. **/
         // const double coordinate_y;		/**< The node's y coordinate. **/
 		// const double capacity;			/**< The node's capacity. **/
@@ -32,8 +32,8 @@ class Node{
 	/************************************/
 
 	// /** Constructor. @param id_ Node id. @param name_ Node name. @param x Node's x coordinate. @param y Node's y coordinate. @param cap Node's capacity. @param cost Node's unitary cost.**/
-	/** Constructor. @param id_ Node id. @param name_ Node name. @param type_ Node type. @param costCU Node's CU cost. @param costDU Node's DU cost.**/
-	Node(const int id_ = -1, const std::string name_ = "", const std::string type_ = "", const double costCU = 0.0, const double costDU = 0.0);
+	/** Constructor. @param store_ The store holding the node's fields. @param id_ Node id. **/
+	Node(const NetworkStore* store_ = NULL, const int id_ = -1) : store(store_), id(id_) {}
     
 
     /************************************/
@@ -41,15 +41,15 @@ class Node{
 	/************************************/
     
 	/** Returns the node's id. **/
-	const int& 			getId() 		 const { return this->id; }
+	int 				getId() 		 const { return this->id; }
 	/** Returns the node's name. **/
-	const std::string& 	getName() 		 const { return this->name; }
+	const std::string& 	getName() 		 const { return store->names.getName(store->nodeName[id]); }
 	/** Returns the node's type. **/
-	const std::string& 	getType() 		 const { return this->type; }
-	/** Returns the node's x coordinate. **/
-	const double& 		getCostCU() const { return this->costCU; }
-	/** Returns the node's y coordinate. **/
-	const double& 		getCostDU() const { return this->costDU; }
+	const std::string& 	getType() 		 const { return store->names.getName(store->nodeType[id]); }
+	/** Returns the node's cost to deploy a CU. **/
+	double 				getCostCU() const { return store->nodeCostCU[id]; }
+	/** Returns the node's cost to deploy a DU. **/
+	double 				getCostDU() const { return store->nodeCostDU[id]; }
 	/** Returns the node's x coordinate. **/
 	// const double& 		getCoordinateX() const { return this->coordinate_x; }
 	// /** Returns the node's y coordinate. **/
@@ -0,0 +1,98 @@
+#include "store.hpp"
+
+/****************************************************************************************/
+/*										Builders										*/
+/****************************************************************************************/
+
+/* Adds a node and returns its id. */
+int NetworkStore::addNode(const std::string& name, const std::string& type, const double costCU, const double costDU)
+{
+    int id = nodeName.size();
+    int nameId = names.intern(name);
+    nodeName.push_back(nameId);
+    nodeType.push_back(names.intern(type));
+    nodeCostCU.push_back(costCU);
+    nodeCostDU.push_back(costDU);
+    if (nameId >= (int)nodeOfName.size()){
+        nodeOfName.resize(nameId + 1, -1);
+    }
+    if (nodeOfName[nameId] < 0){
+        nodeOfName[nameId] = id;
+    }
+    return id;
+}
+
+/* Adds a link and returns its id. */
+int NetworkStore::addLink(const std::string& name, const int source, const int target, const double capacity, const double delay)
+{
+    int id = linkName.size();
+    linkName.push_back(names.intern(name));
+    linkSource.push_back(source);
+    linkTarget.push_back(target);
+    linkCapacity.push_back(capacity);
+    linkDelay.push_back(delay);
+    return id;
+}
+
+/* Adds a demand and returns its id. */
+int NetworkStore::addDemand(const std::string& name, const int source, const double maxLatency, const double throughput)
+{
+    int id = demandName.size();
+    int nameId = names.intern(name);
+    demandName.push_back(nameId);
+    demandSource.push_back(source);
+    demandMaxLatency.push_back(maxLatency);
+    demandThroughput.push_back(throughput);
+    demandCandidate.push_back(-1);
+    demandDU.push_back(-1);
+    demandCU.push_back(-1);
+    if (nameId >= (int)demandOfName.size()){
+        demandOfName.resize(nameId + 1, -1);
+    }
+    if (demandOfName[nameId] < 0){
+        demandOfName[nameId] = id;
+    }
+    return id;
+}
+
+/****************************************************************************************/
+/*										Getters											*/
+/****************************************************************************************/
+
+/* Returns the id of the node with the given name, or -1 if there is none. */
+int NetworkStore::findNode(const std::string& name) const
+{
+    int nameId = names.find(name);
+    return (nameId >= 0 && nameId < (int)nodeOfName.size()) ? nodeOfName[nameId] : -1;
+}
+
+/* Returns the id of the demand with the given name, or -1 if there is none. */
+int NetworkStore::findDemand(const std::string& name) const
+{
+    int nameId = names.find(name);
+    return (nameId >= 0 && nameId < (int)demandOfName.size()) ? demandOfName[nameId] : -1;
+}
+
+/* Returns the memory used by the store. */
+size_t NetworkStore::getMemory() const
+{
+    size_t memory = names.getMemory();
+    memory += (nodeName.capacity() + nodeType.capacity() + nodeOfName.capacity()) * sizeof(int);
+    memory += (nodeCostCU.capacity() + nodeCostDU.capacity()) * sizeof(double);
+    memory += (linkName.capacity() + linkSource.capacity() + linkTarget.capacity()) * sizeof(int);
+    memory += (linkCapacity.capacity() + linkDelay.capacity()) * sizeof(double);
+    memory += (demandName.capacity() + demandSource.capacity() + demandOfName.capacity()) * sizeof(int);
+    memory += (demandCandidate.capacity() + demandDU.capacity() + demandCU.capacity()) * sizeof(int);
+    memory += (demandMaxLatency.capacity() + demandThroughput.capacity()) * sizeof(double);
+    return memory;
+}
+
+/* Empties the store. */
+void NetworkStore::clear()
+{
+    names.clear();
+    nodeName.clear(); nodeType.clear(); nodeCostCU.clear(); nodeCostDU.clear(); nodeOfName.clear();
+    linkName.clear(); linkSource.clear(); linkTarget.clear(); linkCapacity.clear(); linkDelay.clear();
+    demandName.clear(); demandSource.clear(); demandMaxLatency.clear(); demandThroughput.clear(); demandOfName.clear();
+    demandCandidate.clear(); demandDU.clear(); demandCU.clear();
+}
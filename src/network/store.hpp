@@ -0,0 +1,83 @@
+#ifndef __store__hpp
+#define __store__hpp
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*** Own Libraries ***/
+#include "../tools/namepool.hpp"
+
+
+/****************************************************************************************
+ * This structure stores the nodes, links and demands of the network column by column:
+ * one contiguous array per field, indexed by the element id, and one pool holding every
+ * name (and node type) once. Builder loops that read a single field, such as the
+ * throughputs of the demands, go through one dense array instead of striding over whole
+ * objects. Node, Link and Demand are thin views over this store. The store is filled
+ * while reading the instance files and only the placement of the demands changes after.
+****************************************************************************************/
+struct NetworkStore {
+	NamePool 				names;				/**< Every node, link and demand name, and every node type. **/
+
+	/*** Nodes ***/
+	std::vector<int> 		nodeName;			/**< Position of the name of each node in the pool. **/
+	std::vector<int> 		nodeType;			/**< Position of the type of each node in the pool. **/
+	std::vector<double> 	nodeCostCU;			/**< Cost of deploying a CU on each node. **/
+	std::vector<double> 	nodeCostDU;			/**< Cost of deploying a DU on each node. **/
+	std::vector<int> 		nodeOfName;			/**< Node holding each name of the pool (-1 if none). **/
+
+	/*** Links ***/
+	std::vector<int> 		linkName;			/**< Position of the name of each link in the pool. **/
+	std::vector<int> 		linkSource;			/**< Source node of each link. **/
+	std::vector<int> 		linkTarget;			/**< Target node of each link. **/
+	std::vector<double> 	linkCapacity;		/**< Capacity of each link. **/
+	std::vector<double> 	linkDelay;			/**< Propagation delay of each link. **/
+
+	/*** Demands ***/
+	std::vector<int> 		demandName;			/**< Position of the name of each demand in the pool. **/
+	std::vector<int> 		demandSource;		/**< Source (RU) node of each demand. **/
+	std::vector<double> 	demandMaxLatency;	/**< Maximum latency of each demand. **/
+	std::vector<double> 	demandThroughput;	/**< Throughput of each demand. **/
+	std::vector<int> 		demandOfName;		/**< Demand holding each name of the pool (-1 if none). **/
+	std::vector<int> 		demandCandidate;	/**< Chosen candidate of each demand, -1 if not placed. (Output) **/
+	std::vector<int> 		demandDU;			/**< Node hosting the DU of each demand, -1 if not placed. (Output) **/
+	std::vector<int> 		demandCU;			/**< Node hosting the CU of each demand, -1 if not placed. (Output) **/
+
+	/** Returns the number of nodes. **/
+	int getNbNodes() const { return (int)nodeName.size(); }
+
+	/** Returns the number of links. **/
+	int getNbLinks() const { return (int)linkName.size(); }
+
+	/** Returns the number of demands. **/
+	int getNbDemands() const { return (int)demandName.size(); }
+
+	/** Adds a node and returns its id. The first node with a given name is the one found by name. **/
+	int addNode(const std::string& name, const std::string& type, const double costCU, const double costDU);
+
+	/** Adds a link and returns its id. **/
+	int addLink(const std::string& name, const int source, const int target, const double capacity, const double delay);
+
+	/** Adds a demand and returns its id. The first demand with a given name is the one found by name. **/
+	int addDemand(const std::string& name, const int source, const double maxLatency, const double throughput);
+
+	/** Returns the id of the node with the given name, or -1 if there is none. **/
+	int findNode(const std::string& name) const;
+
+	/** Returns the id of the demand with the given name, or -1 if there is none. **/
+	int findDemand(const std::string& name) const;
+
+	/** Returns the memory (in bytes) used by the store. **/
+	size_t getMemory() const;
+
+	/** Empties the store. **/
+	void clear();
+};
+
+#endif
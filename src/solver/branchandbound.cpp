@@ -0,0 +1,595 @@
+#include "branchandbound.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+BranchAndBound::BranchAndBound(const Data& data_) :
+                data(data_), integralCosts(false), rootBound(-DBL_MAX), nbIdle(0), finished(false), stopped(false), nbNodes(0),
+                incumbent(DBL_MAX), bestBound(-DBL_MAX), nbNodesLeft(0), time(0.0)
+{
+    std::cout << "=> Building branch-and-bound ... " << std::endl;
+
+    /* Demands with the largest throughput are the most constrained: branch on them first. */
+    std::vector<double> throughput(data.getNbDemands());
+    for (int i = 0; i < data.getNbDemands(); i++){
+        throughput[i] = data.getDemand(i).getThroughput();
+    }
+    order = getSortedIndexes_Desc(throughput);
+
+    integralCosts = true;
+    for (int i = 0; i < data.getNbDemands() && integralCosts; i++){
+        for (unsigned int c = 0; c < data.getCandidates(i).size() && integralCosts; c++){
+            double cost = data.getCandidates(i)[c].getCost();
+            integralCosts = (cost == std::floor(cost));
+        }
+    }
+
+    setGreedyIncumbent();
+    setLagrangianMultipliers();
+
+    std::cout << "=> Branch-and-bound was correctly built ! " << std::endl;
+}
+
+/****************************************************************************************/
+/*										Bounds											*/
+/****************************************************************************************/
+
+/* Builds a first placement by assigning each demand to its cheapest feasible candidate. */
+void BranchAndBound::setGreedyIncumbent()
+{
+    std::vector<double> residual(data.getNbLinks());
+    for (unsigned int l = 0; l < residual.size(); l++){
+        residual[l] = data.getLink(l).getCapacity();
+    }
+    std::vector<int> choice(data.getNbDemands(), -1);
+    double cost = 0.0;
+    for (unsigned int idx = 0; idx < order.size(); idx++){
+        int i = order[idx];
+        double lambda = data.getDemand(i).getThroughput();
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            bool fits = true;
+            for (unsigned int l = 0; l < candidates[c].getListOfLinks().size() && fits; l++){
+                int link = candidates[c].getListOfLinks()[l];
+                fits = (lambda <= residual[link] + BB_CAPACITY_TOLERANCE*data.getLink(link).getCapacity());
+            }
+            if (fits && (choice[i] < 0 || candidates[c].getCost() < candidates[choice[i]].getCost())){
+                choice[i] = c;
+            }
+        }
+        if (choice[i] < 0){
+            std::cout << "\t Greedy heuristic could not place demand " << data.getDemand(i).getName() << "." << std::endl;
+            return;
+        }
+        for (unsigned int l = 0; l < candidates[choice[i]].getListOfLinks().size(); l++){
+            residual[candidates[choice[i]].getListOfLinks()[l]] -= lambda;
+        }
+        cost += candidates[choice[i]].getCost();
+    }
+    std::cout << "\t Greedy heuristic found a placement of cost " << cost << "." << std::endl;
+    updateIncumbent(choice, cost);
+}
+
+/* Computes the Lagrangian multipliers of the link capacity rows through subgradient optimization. */
+void BranchAndBound::setLagrangianMultipliers()
+{
+    const int NB_LINKS = data.getNbLinks();
+    const int NB_DEMANDS = data.getNbDemands();
+    multiplier.assign(NB_LINKS, 0.0);
+    std::vector<double> u(NB_LINKS, 0.0);
+    std::vector<double> subgradient(NB_LINKS, 0.0);
+    double theta = 2.0;
+    int nbNoImprovement = 0;
+
+    for (int it = 0; it < BB_LAGRANGIAN_ITERATIONS; it++){
+        /* Each demand independently picks the candidate minimizing its penalized cost. */
+        double value = 0.0;
+        for (int l = 0; l < NB_LINKS; l++){
+            value -= u[l] * data.getLink(l).getCapacity();
+            subgradient[l] = -data.getLink(l).getCapacity();
+        }
+        for (int i = 0; i < NB_DEMANDS; i++){
+            double lambda = data.getDemand(i).getThroughput();
+            const std::vector<Candidate>& candidates = data.getCandidates(i);
+            int best = -1;
+            double bestCost = DBL_MAX;
+            for (unsigned int c = 0; c < candidates.size(); c++){
+                double penalized = candidates[c].getCost();
+                for (unsigned int l = 0; l < candidates[c].getListOfLinks().size(); l++){
+                    penalized += lambda * u[candidates[c].getListOfLinks()[l]];
+                }
+                if (penalized < bestCost){
+                    bestCost = penalized;
+                    best = c;
+                }
+            }
+            if (best < 0){
+                /* A demand without candidates makes the problem infeasible. */
+                rootBound = DBL_MAX;
+                return;
+            }
+            value += bestCost;
+            for (unsigned int l = 0; l < candidates[best].getListOfLinks().size(); l++){
+                subgradient[candidates[best].getListOfLinks()[l]] += lambda;
+            }
+        }
+
+        if (value > rootBound + BB_TOLERANCE*std::max(1.0, std::fabs(rootBound))){
+            rootBound = value;
+            multiplier = u;
+            nbNoImprovement = 0;
+        }
+        else if (++nbNoImprovement >= 10){
+            theta /= 2.0;
+            nbNoImprovement = 0;
+        }
+
+        double norm = 0.0;
+        for (int l = 0; l < NB_LINKS; l++){
+            if (u[l] > 0.0 || subgradient[l] > 0.0){
+                norm += subgradient[l]*subgradient[l];
+            }
+        }
+        if (norm <= 0.0 || theta < 1e-4){
+            break;
+        }
+        double target = (incumbent.load() < DBL_MAX) ? incumbent.load() : value + std::max(1.0, std::fabs(value));
+        if (target <= value){
+            break;
+        }
+        double step = theta * (target - value) / norm;
+        for (int l = 0; l < NB_LINKS; l++){
+            u[l] = std::max(0.0, u[l] + step*subgradient[l]);
+        }
+    }
+
+    lagrangianCost.resize(NB_DEMANDS);
+    for (int i = 0; i < NB_DEMANDS; i++){
+        double lambda = data.getDemand(i).getThroughput();
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        lagrangianCost[i].resize(candidates.size());
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            lagrangianCost[i][c] = candidates[c].getCost();
+            for (unsigned int l = 0; l < candidates[c].getListOfLinks().size(); l++){
+                lagrangianCost[i][c] += lambda * multiplier[candidates[c].getListOfLinks()[l]];
+            }
+        }
+    }
+    std::cout << "\t Root Lagrangian bound: " << rootBound << std::endl;
+}
+
+/* Returns the relative gap between the best placement and the best bound. */
+double BranchAndBound::getRelativeGap() const
+{
+    if (!hasSolution()){
+        return DBL_MAX;
+    }
+    double inc = incumbent.load();
+    return std::max(0.0, inc - bestBound) / (BB_CAPACITY_TOLERANCE + std::fabs(inc));
+}
+
+/****************************************************************************************/
+/*										Search											*/
+/****************************************************************************************/
+
+/* Checks if candidate c of demand i fits in the residual capacities of the given workspace. */
+bool BranchAndBound::isFeasible(const BBWorkspace &w, const int i, const int c) const
+{
+    const std::vector<int>& links = data.getCandidates(i)[c].getListOfLinks();
+    double lambda = data.getDemand(i).getThroughput();
+    for (unsigned int l = 0; l < links.size(); l++){
+        if (lambda > w.residual[links[l]] + BB_CAPACITY_TOLERANCE*data.getLink(links[l]).getCapacity()){
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Places demand i on candidate c in the given workspace. */
+void BranchAndBound::apply(BBWorkspace &w, const int i, const int c) const
+{
+    const Candidate& candidate = data.getCandidates(i)[c];
+    double lambda = data.getDemand(i).getThroughput();
+    for (unsigned int l = 0; l < candidate.getListOfLinks().size(); l++){
+        int link = candidate.getListOfLinks()[l];
+        w.residual[link] -= lambda;
+        w.uResidual -= multiplier[link] * lambda;
+    }
+    w.choice[i] = c;
+    w.assignedCost += candidate.getCost();
+    w.path.push_back(std::make_pair(i, c));
+}
+
+/* Removes the placement of demand i on candidate c from the given workspace. */
+void BranchAndBound::undo(BBWorkspace &w, const int i, const int c) const
+{
+    const Candidate& candidate = data.getCandidates(i)[c];
+    double lambda = data.getDemand(i).getThroughput();
+    for (unsigned int l = 0; l < candidate.getListOfLinks().size(); l++){
+        int link = candidate.getListOfLinks()[l];
+        w.residual[link] += lambda;
+        w.uResidual += multiplier[link] * lambda;
+    }
+    w.choice[i] = -1;
+    w.assignedCost -= candidate.getCost();
+    w.path.pop_back();
+}
+
+/* Moves the given workspace to the path ending with the given decision. */
+void BranchAndBound::setPath(BBWorkspace &w, const std::shared_ptr<const BBDecision> &last) const
+{
+    std::vector<std::pair<int, int> > target(last ? last->depth : 0);
+    for (const BBDecision* d = last.get(); d != NULL; d = d->parent.get()){
+        target[d->depth - 1] = std::make_pair(d->demand, d->candidate);
+    }
+    unsigned int common = 0;
+    while (common < w.path.size() && common < target.size() && w.path[common] == target[common]){
+        common++;
+    }
+    while (w.path.size() > common){
+        undo(w, w.path.back().first, w.path.back().second);
+    }
+    for (unsigned int d = common; d < target.size(); d++){
+        apply(w, target[d].first, target[d].second);
+    }
+}
+
+/* Checks if a subtree with the given bound cannot contain a better placement than the incumbent. */
+bool BranchAndBound::isPruned(const double bound) const
+{
+    double inc = incumbent.load();
+    if (inc >= DBL_MAX){
+        return false;
+    }
+    double tolerance = BB_TOLERANCE * std::max(1.0, std::fabs(inc));
+    /* With integer costs, any better placement costs at least one unit less than the incumbent. */
+    if (integralCosts){
+        return std::ceil(bound - tolerance) > inc - 1.0 + tolerance;
+    }
+    return bound >= inc - tolerance;
+}
+
+/* Evaluates a node: propagates, bounds and either prunes, updates the incumbent or branches. */
+void BranchAndBound::evaluate(const int worker, const BBNode &node)
+{
+    BBWorkspace& w = *workers[worker];
+    nbNodes++;
+    w.nbNodes++;
+    if (isPruned(node.bound)){
+        return;
+    }
+    setPath(w, node.last);
+    std::shared_ptr<const BBDecision> last = node.last;
+
+    /* Propagation: demands with a single candidate fitting the residual capacities are fixed. */
+    int branchDemand = -1;
+    double combSum = 0.0, lagSum = 0.0, branchMinCost = 0.0, branchMinLag = 0.0;
+    bool changed = true;
+    while (changed){
+        changed = false;
+        branchDemand = -1;
+        combSum = lagSum = 0.0;
+        for (unsigned int idx = 0; idx < order.size(); idx++){
+            int i = order[idx];
+            if (w.choice[i] >= 0){
+                continue;
+            }
+            int nbFeasible = 0, lastFeasible = -1;
+            double minCost = DBL_MAX, minLag = DBL_MAX;
+            const std::vector<Candidate>& candidates = data.getCandidates(i);
+            for (unsigned int c = 0; c < candidates.size(); c++){
+                if (isFeasible(w, i, c)){
+                    nbFeasible++;
+                    lastFeasible = c;
+                    minCost = std::min(minCost, candidates[c].getCost());
+                    minLag = std::min(minLag, lagrangianCost[i][c]);
+                }
+            }
+            if (nbFeasible == 0){
+                return;
+            }
+            if (nbFeasible == 1){
+                apply(w, i, lastFeasible);
+                std::shared_ptr<BBDecision> forced(new BBDecision());
+                forced->parent = last;
+                forced->demand = i;
+                forced->candidate = lastFeasible;
+                forced->depth = (last ? last->depth : 0) + 1;
+                last = forced;
+                changed = true;
+                continue;
+            }
+            combSum += minCost;
+            lagSum += minLag;
+            if (branchDemand < 0){
+                branchDemand = i;
+                branchMinCost = minCost;
+                branchMinLag = minLag;
+            }
+        }
+    }
+
+    /* Bounding */
+    double combBound = w.assignedCost + combSum;
+    double lagBound = w.assignedCost + lagSum - w.uResidual;
+    double bound = std::max(combBound, lagBound);
+    if (isPruned(bound)){
+        return;
+    }
+    if (branchDemand < 0){
+        updateIncumbent(w.choice, w.assignedCost);
+        return;
+    }
+
+    /* Branching: one child per candidate of the chosen demand, the most promising one explored first. */
+    std::vector<BBNode> children;
+    std::vector<double> childBounds;
+    const std::vector<Candidate>& candidates = data.getCandidates(branchDemand);
+    for (unsigned int c = 0; c < candidates.size(); c++){
+        if (!isFeasible(w, branchDemand, c)){
+            continue;
+        }
+        double childBound = std::max(combBound - branchMinCost + candidates[c].getCost(),
+                                     lagBound - branchMinLag + lagrangianCost[branchDemand][c]);
+        if (isPruned(childBound)){
+            continue;
+        }
+        std::shared_ptr<BBDecision> decision(new BBDecision());
+        decision->parent = last;
+        decision->demand = branchDemand;
+        decision->candidate = c;
+        decision->depth = (last ? last->depth : 0) + 1;
+        BBNode child;
+        child.last = decision;
+        child.bound = childBound;
+        children.push_back(child);
+        childBounds.push_back(childBound);
+    }
+    std::vector<int> sorted = getSortedIndexes_Desc(childBounds);
+    std::lock_guard<std::mutex> lock(w.openMutex);
+    for (unsigned int c = 0; c < sorted.size(); c++){
+        w.open.push_back(children[sorted[c]]);
+    }
+}
+
+/* Fetches a node for the given worker: its own deepest node, then the best-bound pool, then a stolen subtree. */
+bool BranchAndBound::getNode(const int worker, BBNode &node)
+{
+    BBWorkspace& w = *workers[worker];
+    /* Best-bound restart: the worker hands its open nodes to the pool and resumes from the best one. */
+    if (w.nbNodes >= BB_RESTART_NODES){
+        w.nbNodes = 0;
+        std::lock_guard<std::mutex> poolLock(poolMutex);
+        std::lock_guard<std::mutex> lock(w.openMutex);
+        while (!w.open.empty()){
+            pool.push(w.open.back());
+            w.open.pop_back();
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(w.openMutex);
+        if (!w.open.empty()){
+            node = w.open.back();
+            w.open.pop_back();
+            return true;
+        }
+    }
+    {
+        std::lock_guard<std::mutex> lock(poolMutex);
+        if (!pool.empty()){
+            node = pool.top();
+            pool.pop();
+            return true;
+        }
+    }
+    /* Steal the shallowest node, i.e., the largest subtree, of another worker. */
+    for (unsigned int v = 1; v < workers.size(); v++){
+        BBWorkspace& victim = *workers[(worker + v) % workers.size()];
+        std::lock_guard<std::mutex> lock(victim.openMutex);
+        if (!victim.open.empty()){
+            node = victim.open.front();
+            victim.open.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Main loop of a worker thread. */
+void BranchAndBound::work(const int worker)
+{
+    const double timeLimit = data.getInput().getTimeLimit();
+    while (!finished){
+        BBNode node;
+        if (getNode(worker, node)){
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (elapsed > timeLimit){
+                /* Keep the node so that its bound counts in the final best bound. */
+                std::lock_guard<std::mutex> lock(poolMutex);
+                pool.push(node);
+                stopped = true;
+                finished = true;
+                poolCondition.notify_all();
+                return;
+            }
+            evaluate(worker, node);
+            continue;
+        }
+        /* No work was found: wait for other workers to share theirs, or for the end of the search. */
+        std::unique_lock<std::mutex> lock(poolMutex);
+        nbIdle++;
+        while (!finished){
+            if (nbIdle == (int)workers.size() && pool.empty()){
+                bool allEmpty = true;
+                for (unsigned int v = 0; v < workers.size() && allEmpty; v++){
+                    std::lock_guard<std::mutex> openLock(workers[v]->openMutex);
+                    allEmpty = workers[v]->open.empty();
+                }
+                if (allEmpty){
+                    finished = true;
+                    poolCondition.notify_all();
+                    break;
+                }
+            }
+            poolCondition.wait_for(lock, std::chrono::milliseconds(1));
+            if (!pool.empty()){
+                break;
+            }
+            bool available = false;
+            for (unsigned int v = 0; v < workers.size() && !available; v++){
+                std::lock_guard<std::mutex> openLock(workers[v]->openMutex);
+                available = !workers[v]->open.empty();
+            }
+            if (available){
+                break;
+            }
+        }
+        nbIdle--;
+    }
+}
+
+/* Updates the incumbent if the given placement is better. */
+void BranchAndBound::updateIncumbent(const std::vector<int> &choice, const double cost)
+{
+    std::lock_guard<std::mutex> lock(incumbentMutex);
+    if (cost < incumbent.load()){
+        incumbent = cost;
+        bestChoice = choice;
+        std::cout << "\t New incumbent: " << cost << " (nodes: " << nbNodes.load() << ")" << std::endl;
+    }
+}
+
+/* Uses the given placement as incumbent if it is complete, fits the link capacities and beats the current one. */
+void BranchAndBound::setInitialPlacement(const std::vector<int> &choice)
+{
+    std::vector<double> load(data.getNbLinks(), 0.0);
+    double cost = 0.0;
+    for (int i = 0; i < data.getNbDemands(); i++){
+        if (choice[i] < 0){
+            return;
+        }
+        const Candidate& candidate = data.getCandidates(i)[choice[i]];
+        for (unsigned int l = 0; l < candidate.getListOfLinks().size(); l++){
+            load[candidate.getListOfLinks()[l]] += data.getDemand(i).getThroughput();
+        }
+        cost += candidate.getCost();
+    }
+    for (unsigned int l = 0; l < load.size(); l++){
+        if (load[l] > (1.0 + BB_CAPACITY_TOLERANCE)*data.getLink(l).getCapacity()){
+            return;
+        }
+    }
+    updateIncumbent(choice, cost);
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Solves the problem. */
+void BranchAndBound::run()
+{
+    start = std::chrono::steady_clock::now();
+    int nbThreads = data.getInput().getNbThreads();
+    if (nbThreads <= 0){
+        nbThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    std::cout << "=> Running branch-and-bound on " << nbThreads << " thread(s) ..." << std::endl;
+
+    workers.clear();
+    for (int t = 0; t < nbThreads; t++){
+        workers.push_back(std::unique_ptr<BBWorkspace>(new BBWorkspace()));
+        workers[t]->residual.resize(data.getNbLinks());
+        for (int l = 0; l < data.getNbLinks(); l++){
+            workers[t]->residual[l] = data.getLink(l).getCapacity();
+            workers[t]->uResidual += multiplier[l] * data.getLink(l).getCapacity();
+        }
+        workers[t]->choice.assign(data.getNbDemands(), -1);
+        workers[t]->assignedCost = 0.0;
+        workers[t]->nbNodes = 0;
+    }
+
+    if (rootBound < DBL_MAX){
+        BBNode root;
+        root.bound = rootBound;
+        pool.push(root);
+    }
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nbThreads; t++){
+        threads.push_back(std::thread(&BranchAndBound::work, this, t));
+    }
+    for (int t = 0; t < nbThreads; t++){
+        threads[t].join();
+    }
+
+    /* The best bound is the smallest bound among the nodes left open. */
+    bestBound = incumbent.load();
+    nbNodesLeft = pool.size();
+    while (!pool.empty()){
+        bestBound = std::min(bestBound, pool.top().bound);
+        pool.pop();
+    }
+    for (int t = 0; t < nbThreads; t++){
+        nbNodesLeft += workers[t]->open.size();
+        for (unsigned int n = 0; n < workers[t]->open.size(); n++){
+            bestBound = std::min(bestBound, workers[t]->open[n].bound);
+        }
+    }
+    workers.clear();
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* Displays the obtained results. */
+void BranchAndBound::printResult()
+{
+    std::cout << "=> Printing solution ..." << std::endl;
+    if (!hasSolution()){
+        std::cout << (stopped ? "No placement found within the time limit." : "The instance is infeasible.") << std::endl;
+    }
+    else{
+        for (int i = 0; i < data.getNbDemands(); i++) {
+            const Candidate& candidate = data.getCandidates(i)[bestChoice[i]];
+            std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
+            std::cout << "Placement for demand " << data.getDemand(i).getName() << " is : "
+                      << "(" << data.getNode(candidate.getDU()).getName() << "," << data.getNode(candidate.getCU()).getName() << ")" << std::endl;
+        }
+        std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
+        std::cout << "Objective value: " << getObjValue() << std::endl;
+    }
+    std::cout << "Best bound: " << bestBound << std::endl;
+    std::cout << "Status: " << (stopped ? (hasSolution() ? "Feasible" : "Unknown") : (hasSolution() ? "Optimal" : "Infeasible")) << std::endl;
+    std::cout << "Nodes evaluated: " << nbNodes.load() << std::endl;
+    std::cout << "Total time: " << time << std::endl << std::endl;
+}
+
+/* Outputs the obtained results. */
+void BranchAndBound::output()
+{
+    std::string output_file = data.getInput().getOutputFile();
+    if (output_file.empty()){
+        return;
+    }
+
+	std::ofstream fileReport(output_file, std::ios_base::app); // File report
+    // If file_output can't be opened
+    if(!fileReport)
+    {
+        std::cerr << "ERROR: Unable to access output file." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::string demand_name = getInBetweenString(data.getInput().getDemandFile(), "/", ".");
+    std::string node_name = getInBetweenString(data.getInput().getNodeFile(), "/", ".");
+    std::string instance_name = node_name + "_" + demand_name;
+
+    fileReport << instance_name << ";"
+    		   << time << ";"
+    		   << getObjValue() << ";"
+    		   << bestBound << ";"
+    		   << getRelativeGap()*100 << ";"
+    		   << nbNodes.load() << ";"
+    		   << nbNodesLeft*0.001 << ";"
+               << std::endl;
+    fileReport.close();
+}
@@ -0,0 +1,196 @@
+#ifndef __branchandbound__hpp
+#define __branchandbound__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+/*** Own Libraries ***/
+#include "../instance/data.hpp"
+#include "../tools/others.hpp"
+
+/****************************************************************************************/
+/*										CONSTANTS										*/
+/****************************************************************************************/
+#define BB_LAGRANGIAN_ITERATIONS 	200 		// Number of subgradient iterations used for computing the root multipliers
+#define BB_RESTART_NODES 			5000 		// Number of nodes a worker explores in depth-first before restarting from the best bound
+#define BB_TOLERANCE 				1e-6 		// Relative tolerance used for pruning nodes against the incumbent
+#define BB_CAPACITY_TOLERANCE 		1e-10 		// Relative tolerance used when checking link capacities
+
+
+/********************************************************************************************
+ * A decision of the branch-and-bound tree: the given demand is placed on the given
+ * candidate. Decisions are chained towards the root so that nodes share their prefix.
+********************************************************************************************/
+struct BBDecision {
+	std::shared_ptr<const BBDecision> 	parent;		/**< The previous decision on the path from the root (NULL at the root). **/
+	int 								demand;		/**< Demand index. **/
+	int 								candidate;	/**< Candidate index inside the demand's candidate list. **/
+	int 								depth;		/**< Number of decisions on the path from the root. **/
+};
+
+/********************************************************************************************
+ * An open node of the branch-and-bound tree.
+********************************************************************************************/
+struct BBNode {
+	std::shared_ptr<const BBDecision> 	last;		/**< The last decision taken (NULL for the root node). **/
+	double 								bound;		/**< A lower bound on the cost of any placement in the subtree. **/
+};
+
+/** Orders nodes so that the node with smallest bound is at the top of a priority queue. **/
+struct BBNodeCompare {
+	bool operator()(const BBNode &a, const BBNode &b) const { return a.bound > b.bound; }
+};
+
+/********************************************************************************************
+ * The state of a worker: the current path from the root and the residual capacities and
+ * placements it induces. Moving from one node to another only undoes and redoes the
+ * decisions that are not shared by both paths.
+********************************************************************************************/
+struct BBWorkspace {
+	std::vector<std::pair<int, int> > 	path;				/**< Decisions (demand, candidate) of the current path. **/
+	std::vector<double> 				residual;			/**< Residual capacity of each link. **/
+	std::vector<int> 					choice;				/**< Chosen candidate of each demand (-1 if unassigned). **/
+	double 								assignedCost;		/**< Cost of the assigned demands. **/
+	double 								uResidual;			/**< Sum over links of multiplier times residual capacity. **/
+	std::deque<BBNode> 					open;				/**< Open nodes owned by the worker. **/
+	std::mutex 							openMutex;			/**< Protects the open nodes against stealing. **/
+	long 								nbNodes;			/**< Number of nodes evaluated by the worker since the last restart. **/
+};
+
+/********************************************************************************************
+ * This class solves the placement problem with a dedicated combinatorial branch-and-bound
+ * that runs directly on Data, without CPLEX. Each demand picks exactly one placement
+ * candidate subject to the link capacities. Bounds combine the cheapest feasible candidate
+ * of each unassigned demand with a Lagrangian relaxation of the capacity rows whose
+ * multipliers are computed by subgradient at the root. Residual capacities are propagated
+ * at each node, demands are branched on by decreasing throughput and the tree is explored
+ * depth-first with periodic restarts from the best bound. Subtrees are shared among
+ * threads through work stealing.
+********************************************************************************************/
+class BranchAndBound
+{
+	private:
+		const Data&     					data;   			/**< Data read in data.hpp **/
+		std::vector<int> 					order;				/**< Demands sorted by decreasing throughput. **/
+		bool 								integralCosts;		/**< True if every placement cost is integer. **/
+		std::vector<double> 				multiplier;			/**< Lagrangian multiplier of each link capacity row. **/
+		std::vector<std::vector<double> > 	lagrangianCost;		/**< Candidate cost plus the Lagrangian penalty of its links. **/
+		double 								rootBound;			/**< Lower bound obtained at the root. **/
+
+		/*** Search ***/
+		std::vector<std::unique_ptr<BBWorkspace> > 	workers;	/**< The workspace of each thread. **/
+		std::priority_queue<BBNode, std::vector<BBNode>, BBNodeCompare> pool;	/**< Nodes waiting for a best-bound restart. **/
+		std::mutex 							poolMutex;			/**< Protects the pool and the idle counter. **/
+		std::condition_variable 			poolCondition;		/**< Wakes up idle workers. **/
+		int 								nbIdle;				/**< Number of workers without work. **/
+		std::atomic<bool> 					finished;			/**< True when the search is over. **/
+		std::atomic<bool> 					stopped;			/**< True when the time limit was reached. **/
+		std::atomic<long> 					nbNodes;			/**< Number of nodes evaluated. **/
+		std::chrono::steady_clock::time_point start;			/**< Time at which the search started. **/
+
+		/*** Incumbent ***/
+		std::atomic<double> 				incumbent;			/**< Cost of the best placement found. **/
+		std::vector<int> 					bestChoice;			/**< Chosen candidate of each demand in the best placement. **/
+		std::mutex 							incumbentMutex;		/**< Protects the best placement. **/
+
+		/*** Results ***/
+		double 								bestBound;			/**< Best lower bound at the end of the search. **/
+		long 								nbNodesLeft;		/**< Number of open nodes at the end of the search. **/
+		double 								time;				/**< Time (in seconds) spent on the search. **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. Orders the demands and computes the root Lagrangian multipliers. **/
+		BranchAndBound(const Data& data);
+		BranchAndBound(const Data&&) = delete;
+		BranchAndBound() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns the cost of the best placement found (infinity if none). **/
+		double getObjValue() const { return incumbent.load(); }
+
+		/** Returns the best lower bound. **/
+		const double& getBestObjValue() const { return bestBound; }
+
+		/** Returns the chosen candidate of each demand in the best placement (empty if none). **/
+		const std::vector<int>& getPlacement() const { return bestChoice; }
+
+		/** Returns true if a placement was found. **/
+		bool hasSolution() const { return !bestChoice.empty(); }
+
+		/** Returns the relative gap between the best placement and the best bound. **/
+		double getRelativeGap() const;
+
+	/****************************************************************************************/
+	/*										Bounds											*/
+	/****************************************************************************************/
+		/** Computes the Lagrangian multipliers of the link capacity rows through subgradient optimization. **/
+		void setLagrangianMultipliers();
+
+		/** Builds a first placement by assigning each demand to its cheapest feasible candidate. **/
+		void setGreedyIncumbent();
+
+	/****************************************************************************************/
+	/*										Search											*/
+	/****************************************************************************************/
+		/** Checks if candidate c of demand i fits in the residual capacities of the given workspace. **/
+		bool isFeasible(const BBWorkspace &w, const int i, const int c) const;
+
+		/** Places demand i on candidate c in the given workspace. **/
+		void apply(BBWorkspace &w, const int i, const int c) const;
+
+		/** Removes the placement of demand i on candidate c from the given workspace. **/
+		void undo(BBWorkspace &w, const int i, const int c) const;
+
+		/** Moves the given workspace to the path ending with the given decision. **/
+		void setPath(BBWorkspace &w, const std::shared_ptr<const BBDecision> &last) const;
+
+		/** Checks if a subtree with the given bound cannot contain a better placement than the incumbent. **/
+		bool isPruned(const double bound) const;
+
+		/** Evaluates a node: propagates, bounds and either prunes, updates the incumbent or branches. **/
+		void evaluate(const int worker, const BBNode &node);
+
+		/** Fetches a node for the given worker: its own deepest node, then the best-bound pool, then a stolen subtree. **/
+		bool getNode(const int worker, BBNode &node);
+
+		/** Main loop of a worker thread. **/
+		void work(const int worker);
+
+		/** Updates the incumbent if the given placement is better. **/
+		void updateIncumbent(const std::vector<int> &choice, const double cost);
+
+		/** Uses the given placement (chosen candidate of each demand) as incumbent if it is complete, fits the link capacities and beats the current one. **/
+		void setInitialPlacement(const std::vector<int> &choice);
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Solves the problem. **/
+		void run();
+
+		/** Displays the obtained results **/
+		void printResult();
+
+		/** Outputs the obtained results **/
+		void output();
+};
+
+
+#endif
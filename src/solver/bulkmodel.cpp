@@ -0,0 +1,375 @@
+#include "bulkmodel.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+BulkModel::BulkModel(const Data& data_) : data(data_), conditioning(data_), env(NULL), lp(NULL), nbThreads(1),
+                status(0), objValue(0.0), bestBound(0.0), gap(0.0), nbNodes(0), nbNodesLeft(0),
+                hasSolution(false), buildTime(0.0), time(0.0)
+{
+    std::cout << "=> Building model through the callable library ... " << std::endl;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    nbThreads = data.getInput().getNbThreads();
+    if (nbThreads <= 0){
+        nbThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    setRows();
+    setColumns();
+    load();
+    conditioning.print();
+
+    buildTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "\t " << getNbColumns() << " columns, " << getNbRows() << " rows and " << getNbNonZeros() << " non-zeros loaded in " << buildTime << " seconds." << std::endl;
+    std::cout << "=> Model was correctly built ! " << std::endl;
+}
+
+/****************************************************************************************/
+/*										Getters											*/
+/****************************************************************************************/
+
+/* Returns the chosen candidate of each demand (-1 if none). */
+std::vector<int> BulkModel::getPlacement() const
+{
+    std::vector<int> placement(data.getNbDemands(), -1);
+    if (!hasSolution){
+        return placement;
+    }
+    for (int i = 0; i < data.getNbDemands(); i++){
+        for (int col = columnStart[i]; col < columnStart[i+1]; col++){
+            if (solution[col] > 1 - BULK_INTEGRALITY_TOLERANCE){
+                placement[i] = col - columnStart[i];
+            }
+        }
+    }
+    return placement;
+}
+
+/****************************************************************************************/
+/*										Assembly										*/
+/****************************************************************************************/
+
+/* Numbers the rows and fills their sense and right-hand side. */
+void BulkModel::setRows()
+{
+    const int NB_DEMANDS = data.getNbDemands();
+    const int NB_LINKS = data.getNbLinks();
+
+    /* Placement rows: each demand picks exactly one candidate. */
+    rhs.assign(NB_DEMANDS, 1.0);
+    sense.assign(NB_DEMANDS, 'E');
+
+    /* Capacity rows: only active links used by some candidate. */
+    std::vector<bool> used(NB_LINKS, false);
+    for (int i = 0; i < NB_DEMANDS; i++){
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            for (unsigned int l = 0; l < candidates[c].getListOfLinks().size(); l++){
+                used[candidates[c].getListOfLinks()[l]] = true;
+            }
+        }
+    }
+    capacityRow.assign(NB_LINKS, -1);
+    for (int l = 0; l < NB_LINKS; l++){
+        if (used[l] && data.isCapacityActive(l)){
+            capacityRow[l] = rhs.size();
+            rhs.push_back(conditioning.throughput(data.getLink(l).getCapacity()));
+            sense.push_back('L');
+        }
+    }
+
+    /* Symmetry rows: the throughput hosted by a node of an orbit is at least the one hosted by the next node. */
+    symmetryPlusRow.assign(data.getNbNodes(), -1);
+    symmetryMinusRow.assign(data.getNbNodes(), -1);
+    if (data.getInput().isSymmetryBreaking()){
+        Symmetry symmetry(data);
+        symmetry.run();
+        symmetry.print();
+        const std::vector<std::vector<int> >& orbits = symmetry.getOrbits();
+        for (unsigned int o = 0; o < orbits.size(); o++){
+            for (unsigned int n = 0; n + 1 < orbits[o].size(); n++){
+                symmetryPlusRow[orbits[o][n]] = rhs.size();
+                symmetryMinusRow[orbits[o][n+1]] = rhs.size();
+                rhs.push_back(0.0);
+                sense.push_back('G');
+            }
+        }
+    }
+}
+
+/* Assembles the columns of the demands in [first, last) into the given local arrays. */
+void BulkModel::assembleRange(const int first, const int last, std::vector<int> &count, std::vector<int> &index, std::vector<double> &value) const
+{
+    for (int i = first; i < last; i++){
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        double lambda = conditioning.throughput(data.getDemand(i).getThroughput());
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            size_t begin = index.size();
+            index.push_back(i);
+            value.push_back(1.0);
+            const std::vector<int>& links = candidates[c].getListOfLinks();
+            for (unsigned int l = 0; l < links.size(); l++){
+                if (capacityRow[links[l]] >= 0){
+                    index.push_back(capacityRow[links[l]]);
+                    value.push_back(lambda);
+                }
+            }
+            /* Symmetry coefficients: a DU and a CU on two consecutive nodes of an orbit cancel out. */
+            int nodes[2] = {candidates[c].getDU(), candidates[c].getCU()};
+            int nbNodes = (nodes[0] == nodes[1]) ? 1 : 2;
+            int symmetryIndex[4];
+            double symmetryValue[4];
+            int nbSymmetry = 0;
+            for (int n = 0; n < nbNodes; n++){
+                int rows[2] = {symmetryPlusRow[nodes[n]], symmetryMinusRow[nodes[n]]};
+                double signs[2] = {lambda, -lambda};
+                for (int s = 0; s < 2; s++){
+                    if (rows[s] < 0){
+                        continue;
+                    }
+                    int k = 0;
+                    while (k < nbSymmetry && symmetryIndex[k] != rows[s]){
+                        k++;
+                    }
+                    if (k == nbSymmetry){
+                        symmetryIndex[k] = rows[s];
+                        symmetryValue[k] = 0.0;
+                        nbSymmetry++;
+                    }
+                    symmetryValue[k] += signs[s];
+                }
+            }
+            for (int k = 0; k < nbSymmetry; k++){
+                if (symmetryValue[k] != 0.0){
+                    index.push_back(symmetryIndex[k]);
+                    value.push_back(symmetryValue[k]);
+                }
+            }
+            count.push_back(index.size() - begin);
+        }
+    }
+}
+
+/* Assembles every column on several threads. */
+void BulkModel::setColumns()
+{
+    const int NB_DEMANDS = data.getNbDemands();
+    columnStart.assign(NB_DEMANDS + 1, 0);
+    for (int i = 0; i < NB_DEMANDS; i++){
+        columnStart[i+1] = columnStart[i] + data.getCandidates(i).size();
+    }
+    const int NB_COLUMNS = columnStart[NB_DEMANDS];
+    objective.resize(NB_COLUMNS);
+    for (int i = 0; i < NB_DEMANDS; i++){
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            objective[columnStart[i] + c] = conditioning.cost(candidates[c].getCost());
+        }
+    }
+
+    /* Each thread assembles a block of demands into its own arrays, which are then concatenated. */
+    int nbBlocks = std::max(1, std::min(nbThreads, NB_DEMANDS / BULK_MIN_DEMANDS_PER_THREAD));
+    std::vector<std::vector<int> > counts(nbBlocks), indexes(nbBlocks);
+    std::vector<std::vector<double> > values(nbBlocks);
+    std::vector<std::thread> threads;
+    for (int b = 0; b < nbBlocks; b++){
+        int first = (long)NB_DEMANDS * b / nbBlocks;
+        int last = (long)NB_DEMANDS * (b + 1) / nbBlocks;
+        threads.push_back(std::thread(&BulkModel::assembleRange, this, first, last, std::ref(counts[b]), std::ref(indexes[b]), std::ref(values[b])));
+    }
+    size_t nbNonZeros = 0;
+    for (int b = 0; b < nbBlocks; b++){
+        threads[b].join();
+        nbNonZeros += indexes[b].size();
+    }
+
+    matcnt.clear();
+    matind.clear();
+    matval.clear();
+    matcnt.reserve(NB_COLUMNS);
+    matind.reserve(nbNonZeros);
+    matval.reserve(nbNonZeros);
+    for (int b = 0; b < nbBlocks; b++){
+        matcnt.insert(matcnt.end(), counts[b].begin(), counts[b].end());
+        matind.insert(matind.end(), indexes[b].begin(), indexes[b].end());
+        matval.insert(matval.end(), values[b].begin(), values[b].end());
+    }
+    matbeg.assign(NB_COLUMNS, 0);
+    for (int col = 1; col < NB_COLUMNS; col++){
+        matbeg[col] = matbeg[col-1] + matcnt[col-1];
+    }
+}
+
+/* Loads the flat problem into CPLEX and sets the parameters. */
+void BulkModel::load()
+{
+    int code = 0;
+    env = CPXopenCPLEX(&code);
+    check(code, "CPXopenCPLEX");
+    check(CPXsetintparam(env, CPXPARAM_ScreenOutput, CPX_ON), "CPXsetintparam");
+    lp = CPXcreateprob(env, &code, "placement");
+    check(code, "CPXcreateprob");
+
+    std::vector<double> lb(getNbColumns(), 0.0), ub(getNbColumns(), 1.0);
+    check(CPXcopylp(env, lp, getNbColumns(), getNbRows(), CPX_MIN, objective.data(), rhs.data(), sense.data(),
+                    matbeg.data(), matcnt.data(), matind.data(), matval.data(), lb.data(), ub.data(), NULL), "CPXcopylp");
+    if (!data.getInput().isRelaxation()){
+        std::vector<char> ctype(getNbColumns(), 'B');
+        check(CPXcopyctype(env, lp, ctype.data()), "CPXcopyctype");
+    }
+
+    if (!data.getInput().getCplexParamFile().empty()){
+        check(CPXreadcopyparam(env, data.getInput().getCplexParamFile().c_str()), "CPXreadcopyparam");
+    }
+    check(CPXsetdblparam(env, CPXPARAM_TimeLimit, data.getInput().getTimeLimit()), "CPXsetdblparam");
+    if (data.getInput().getNbThreads() > 0){
+        check(CPXsetintparam(env, CPXPARAM_Threads, data.getInput().getNbThreads()), "CPXsetintparam");
+    }
+}
+
+/* Stops the program if a CPLEX call failed. */
+void BulkModel::check(const int code, const std::string &call) const
+{
+    if (code != 0){
+        char buffer[CPXMESSAGEBUFSIZE];
+        const char* message = CPXgeterrorstring(env, code, buffer);
+        std::cerr << "ERROR: " << call << " failed (" << code << "): " << (message != NULL ? buffer : "unknown error") << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Installs the given placement as a MIP start. */
+void BulkModel::setMipStart(const std::vector<int>& placement)
+{
+    std::vector<int> indices;
+    std::vector<double> values;
+    bool complete = true;
+    for (int i = 0; i < data.getNbDemands(); i++){
+        if (placement[i] < 0){
+            complete = false;
+            continue;
+        }
+        for (int col = columnStart[i]; col < columnStart[i+1]; col++){
+            indices.push_back(col);
+            values.push_back(col - columnStart[i] == placement[i] ? 1.0 : 0.0);
+        }
+    }
+    if (indices.empty()){
+        return;
+    }
+    int beg = 0;
+    int effort = complete ? CPX_MIPSTART_REPAIR : CPX_MIPSTART_SOLVEMIP;
+    check(CPXaddmipstarts(env, lp, 1, indices.size(), &beg, indices.data(), values.data(), &effort, NULL), "CPXaddmipstarts");
+}
+
+/* Solves the problem. */
+void BulkModel::run()
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool mip = !data.getInput().isRelaxation();
+    if (mip){
+        check(CPXmipopt(env, lp), "CPXmipopt");
+    }
+    else{
+        check(CPXlpopt(env, lp), "CPXlpopt");
+    }
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    status = CPXgetstat(env, lp);
+    hasSolution = (CPXgetobjval(env, lp, &objValue) == 0);
+    if (hasSolution){
+        solution.resize(getNbColumns());
+        if (getNbColumns() > 0){
+            check(CPXgetx(env, lp, solution.data(), 0, getNbColumns() - 1), "CPXgetx");
+        }
+    }
+    bestBound = objValue;
+    if (mip){
+        CPXgetbestobjval(env, lp, &bestBound);
+        if (hasSolution){
+            CPXgetmiprelgap(env, lp, &gap);
+        }
+        nbNodes = CPXgetnodecnt(env, lp);
+        nbNodesLeft = CPXgetnodeleftcnt(env, lp);
+    }
+    /* Back to the original cost unit. */
+    objValue = conditioning.unscaleCost(objValue);
+    bestBound = conditioning.unscaleCost(bestBound);
+}
+
+/* Displays the obtained results. */
+void BulkModel::printResult()
+{
+    std::cout << "=> Printing solution ..." << std::endl;
+    std::vector<int> placement = getPlacement();
+    for (int i = 0; i < data.getNbDemands(); i++){
+        std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
+        std::cout << "Placement for demand " << data.getDemand(i).getName() << " is : ";
+        if (placement[i] >= 0){
+            const Candidate& candidate = data.getCandidates(i)[placement[i]];
+            std::cout << "(" << data.getNode(candidate.getDU()).getName() << "," << data.getNode(candidate.getCU()).getName() << ")" << ", ";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
+
+    char buffer[CPXMESSAGEBUFSIZE];
+    CPXgetstatstring(env, status, buffer);
+    std::cout << "Status: " << buffer << std::endl;
+    std::cout << "Objective value: " << objValue << std::endl;
+    std::cout << "Nodes evaluated: " << nbNodes << std::endl;
+    std::cout << "Build time: " << buildTime << std::endl;
+    std::cout << "Total time: " << time << std::endl << std::endl;
+}
+
+/* Outputs the obtained results. */
+void BulkModel::output()
+{
+    std::string output_file = data.getInput().getOutputFile();
+    if (output_file.empty()){
+        return;
+    }
+
+    std::ofstream fileReport(output_file, std::ios_base::app); // File report
+    // If file_output can't be opened
+    if(!fileReport)
+    {
+        std::cerr << "ERROR: Unable to access output file." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::string demand_name = getInBetweenString(data.getInput().getDemandFile(), "/", ".");
+    std::string node_name = getInBetweenString(data.getInput().getNodeFile(), "/", ".");
+    std::string instance_name = node_name + "_" + demand_name;
+
+    fileReport << instance_name << ";"
+               << time << ";"
+               << objValue << ";"
+               << bestBound << ";"
+               << gap*100 << ";"
+               << nbNodes << ";"
+               << nbNodesLeft*0.001 << ";"
+               << std::endl;
+
+    // Finalization ***
+    fileReport.close();
+}
+
+/****************************************************************************************/
+/*										Destructors 									*/
+/****************************************************************************************/
+
+BulkModel::~BulkModel()
+{
+    if (lp != NULL){
+        CPXfreeprob(env, &lp);
+    }
+    if (env != NULL){
+        CPXcloseCPLEX(&env);
+    }
+}
@@ -0,0 +1,148 @@
+#ifndef __bulkmodel__hpp
+#define __bulkmodel__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <chrono>
+#include <thread>
+
+/*** CPLEX Libraries ***/
+#include <ilcplex/cplex.h>
+
+/*** Own Libraries ***/
+#include "../instance/data.hpp"
+#include "../instance/symmetry.hpp"
+#include "../instance/conditioning.hpp"
+#include "../tools/others.hpp"
+
+/****************************************************************************************/
+/*										CONSTANTS										*/
+/****************************************************************************************/
+#define BULK_MIN_DEMANDS_PER_THREAD 	1000 	// Minimum number of demands assembled by each thread
+#define BULK_INTEGRALITY_TOLERANCE 		1e-4 	// Tolerance used for reading binary values
+
+
+/********************************************************************************************
+ * This class builds the same formulation as Model (one column per placement candidate, one
+ * placement row per demand, one capacity row per active link and, optionally, the
+ * symmetry-breaking rows) without Concert. Columns are assembled on several threads
+ * directly into flat column-wise (CSC) arrays of objective, bounds and coefficients, and
+ * handed to the CPLEX callable library in a single CPXcopylp call. The solution is read
+ * back in one CPXgetx call through a light index: the columns of demand i are
+ * columnStart[i] ... columnStart[i+1]-1, in the order of its candidates.
+********************************************************************************************/
+class BulkModel
+{
+	private:
+		const Data&     		data;   			/**< Data read in data.hpp **/
+		Conditioning 			conditioning;		/**< Units in which throughputs, capacities and costs are written. **/
+		CPXENVptr 				env;				/**< CPLEX environment **/
+		CPXLPptr 				lp;					/**< CPLEX problem **/
+		int 					nbThreads;			/**< Number of threads used for assembling the columns. **/
+
+		/*** Index ***/
+		std::vector<int> 		columnStart;		/**< First column of each demand (size: demands + 1). **/
+		std::vector<int> 		capacityRow;		/**< Row of the capacity constraint of each link (-1 if not written). **/
+		std::vector<int> 		symmetryPlusRow;	/**< Symmetry row where the node's hosted throughput counts positively (-1 if none). **/
+		std::vector<int> 		symmetryMinusRow;	/**< Symmetry row where the node's hosted throughput counts negatively (-1 if none). **/
+
+		/*** Flat problem ***/
+		std::vector<double> 	objective;			/**< Objective coefficient of each column. **/
+		std::vector<double> 	rhs;				/**< Right-hand side of each row. **/
+		std::vector<char> 		sense;				/**< Sense of each row ('E', 'L' or 'G'). **/
+		std::vector<int> 		matbeg;				/**< Position of the first coefficient of each column. **/
+		std::vector<int> 		matcnt;				/**< Number of coefficients of each column. **/
+		std::vector<int> 		matind;				/**< Row of each coefficient. **/
+		std::vector<double> 	matval;				/**< Value of each coefficient. **/
+
+		/*** Results ***/
+		std::vector<double> 	solution;			/**< Value of each column. **/
+		int 					status;				/**< CPLEX status code. **/
+		double 					objValue;			/**< Objective value of the best solution. **/
+		double 					bestBound;			/**< Best lower bound. **/
+		double 					gap;				/**< Relative MIP gap. **/
+		long 					nbNodes;			/**< Number of nodes evaluated. **/
+		long 					nbNodesLeft;		/**< Number of open nodes left. **/
+		bool 					hasSolution;		/**< True if a solution is available. **/
+		double 					buildTime;			/**< Time (in seconds) spent on assembling and loading the problem. **/
+		double 					time;				/**< Time (in seconds) spent on solving. **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. Assembles the problem and loads it into CPLEX. **/
+		BulkModel(const Data& data);
+		BulkModel(const Data&&) = delete;
+		BulkModel() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns the column of candidate c of demand i. **/
+		int getColumn(const int i, const int c) const { return columnStart[i] + c; }
+
+		/** Returns the number of columns. **/
+		int getNbColumns() const { return objective.size(); }
+
+		/** Returns the number of rows. **/
+		int getNbRows() const { return rhs.size(); }
+
+		/** Returns the number of non-zero coefficients. **/
+		long getNbNonZeros() const { return matind.size(); }
+
+		/** Returns the time (in seconds) spent on assembling and loading the problem. **/
+		const double& getBuildTime() const { return buildTime; }
+
+		/** Returns true if a solution is available after run(). **/
+		bool isSolutionAvailable() const { return hasSolution; }
+
+		/** Returns the chosen candidate of each demand (-1 if none). **/
+		std::vector<int> getPlacement() const;
+
+	/****************************************************************************************/
+	/*										Assembly										*/
+	/****************************************************************************************/
+		/** Numbers the rows and fills their sense and right-hand side. **/
+		void setRows();
+
+		/** Assembles the columns of the demands in [first, last) into the given local arrays. **/
+		void assembleRange(const int first, const int last, std::vector<int> &count, std::vector<int> &index, std::vector<double> &value) const;
+
+		/** Assembles every column on several threads. **/
+		void setColumns();
+
+		/** Loads the flat problem into CPLEX and sets the parameters. **/
+		void load();
+
+		/** Stops the program if a CPLEX call failed. **/
+		void check(const int code, const std::string &call) const;
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Installs the given placement (chosen candidate of each demand, -1 if none) as a MIP start. **/
+		void setMipStart(const std::vector<int>& placement);
+
+		/** Solves the problem. **/
+		void run();
+
+		/** Displays the obtained results **/
+		void printResult();
+
+		/** Outputs the obtained results **/
+		void output();
+
+	/****************************************************************************************/
+	/*										Destructors 									*/
+	/****************************************************************************************/
+		/** Destructor. Frees the CPLEX problem and environment. **/
+		~BulkModel();
+};
+
+
+#endif
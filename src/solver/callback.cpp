@@ -0,0 +1,207 @@
+#include "callback.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+CoverCutCallback::CoverCutCallback(const IloEnv& env_, const Data& data, const std::vector<int>& demands, const IloNumVarMatrix& z) :
+                                    env(env_), columns(env), nbUserCuts(0), nbRootCuts(0), nbCalls(0), time(0.0),
+                                    rootSeen(false), rootBoundBefore(0.0), rootBoundAfter(0.0)
+{
+    /* Columns of every demand using each link, a candidate crossing the link twice being counted once. */
+    const int NB_LINKS = data.getNbLinks();
+    std::vector<std::vector<std::pair<int, int> > > users(NB_LINKS);
+    std::vector<int> seen(NB_LINKS, -1);
+    for (unsigned int d = 0; d < demands.size(); d++){
+        int i = demands[d];
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            int col = columns.getSize();
+            columns.add(z[i][c]);
+            const std::vector<int>& links = candidates[c].getListOfLinks();
+            for (unsigned int l = 0; l < links.size(); l++){
+                if (seen[links[l]] != col){
+                    seen[links[l]] = col;
+                    users[links[l]].push_back(std::make_pair(i, col));
+                }
+            }
+        }
+    }
+
+    /* Only rows that the demands using them can overload may hold a violated cover. */
+    for (int l = 0; l < NB_LINKS; l++){
+        if (!data.isCapacityActive(l) || users[l].empty()){
+            continue;
+        }
+        Knapsack knapsack;
+        knapsack.link = l;
+        knapsack.capacity = data.getLink(l).getCapacity();
+        std::vector<int> item(data.getNbDemands(), -1);
+        double total = 0.0;
+        for (unsigned int u = 0; u < users[l].size(); u++){
+            int i = users[l][u].first;
+            if (item[i] < 0){
+                item[i] = knapsack.demands.size();
+                knapsack.demands.push_back(i);
+                knapsack.weights.push_back(data.getDemand(i).getThroughput());
+                knapsack.columns.push_back(std::vector<int>());
+                total += data.getDemand(i).getThroughput();
+            }
+            knapsack.columns[item[i]].push_back(users[l][u].second);
+        }
+        if (total <= knapsack.capacity * (1 + COVER_TOLERANCE)){
+            continue;
+        }
+
+        /* Items are stored by decreasing throughput, as the lifting needs them. */
+        std::vector<int> order(knapsack.demands.size());
+        for (unsigned int k = 0; k < order.size(); k++){
+            order[k] = k;
+        }
+        std::stable_sort(order.begin(), order.end(), [&knapsack](const int a, const int b){ return knapsack.weights[a] > knapsack.weights[b]; });
+        Knapsack sorted;
+        sorted.link = knapsack.link;
+        sorted.capacity = knapsack.capacity;
+        for (unsigned int k = 0; k < order.size(); k++){
+            sorted.demands.push_back(knapsack.demands[order[k]]);
+            sorted.weights.push_back(knapsack.weights[order[k]]);
+            sorted.columns.push_back(knapsack.columns[order[k]]);
+        }
+        knapsacks.push_back(sorted);
+    }
+    std::cout << "\t > Cover cuts will be separated on " << knapsacks.size() << " link capacity row(s). " << std::endl;
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Separates a lifted cover inequality on the given row. Returns false if none is violated by the given point. */
+bool CoverCutCallback::separate(const Knapsack& knapsack, const IloNumArray& values, IloExpr& cut, double& rhs) const
+{
+    const int NB_ITEMS = knapsack.demands.size();
+    const double limit = knapsack.capacity * (1 + COVER_TOLERANCE);
+
+    /* y[k]: share of the k-th demand routed through the link. Demands at zero cannot be in a violated cover. */
+    std::vector<double> y(NB_ITEMS, 0.0);
+    std::vector<int> support;
+    double load = 0.0;
+    for (int k = 0; k < NB_ITEMS; k++){
+        for (unsigned int c = 0; c < knapsack.columns[k].size(); c++){
+            y[k] += values[knapsack.columns[k][c]];
+        }
+        y[k] = std::min(1.0, y[k]);
+        if (y[k] > EPSILON){
+            support.push_back(k);
+            load += knapsack.weights[k];
+        }
+    }
+    if (load <= limit){
+        return false;
+    }
+
+    /* Greedy cover: the demands closest to 1 per unit of throughput first. */
+    std::stable_sort(support.begin(), support.end(), [&](const int a, const int b){
+        return (1.0 - y[a]) * knapsack.weights[b] < (1.0 - y[b]) * knapsack.weights[a];
+    });
+    std::vector<int> cover;
+    double weight = 0.0;
+    for (unsigned int s = 0; s < support.size() && weight <= limit; s++){
+        cover.push_back(support[s]);
+        weight += knapsack.weights[support[s]];
+    }
+
+    /* Minimal cover: the demands with the smallest share leave first, as long as the rest still overloads the link. */
+    std::stable_sort(cover.begin(), cover.end(), [&y](const int a, const int b){ return y[a] < y[b]; });
+    std::vector<bool> inCover(NB_ITEMS, false);
+    std::vector<int> minimal;
+    for (unsigned int k = 0; k < cover.size(); k++){
+        if (weight - knapsack.weights[cover[k]] > limit){
+            weight -= knapsack.weights[cover[k]];
+        }
+        else{
+            minimal.push_back(cover[k]);
+            inCover[cover[k]] = true;
+        }
+    }
+
+    /* prefix[h]: throughput of the h largest demands of the cover (items are sorted by decreasing throughput). */
+    std::vector<double> prefix(1, 0.0);
+    for (int k = 0; k < NB_ITEMS; k++){
+        if (inCover[k]){
+            prefix.push_back(prefix.back() + knapsack.weights[k]);
+        }
+    }
+    const int SIZE = minimal.size();
+
+    /* Lifting: a demand outside the cover weighing at least the h largest demands of the cover gets coefficient h. */
+    std::vector<int> coefficient(NB_ITEMS, 0);
+    double lhs = 0.0;
+    for (int k = 0; k < NB_ITEMS; k++){
+        if (inCover[k]){
+            coefficient[k] = 1;
+        }
+        else{
+            coefficient[k] = std::upper_bound(prefix.begin(), prefix.end(), knapsack.weights[k]) - prefix.begin() - 1;
+            coefficient[k] = std::min(coefficient[k], SIZE);
+        }
+        lhs += coefficient[k] * y[k];
+    }
+    rhs = SIZE - 1;
+    if (lhs <= rhs + COVER_VIOLATION){
+        return false;
+    }
+
+    for (int k = 0; k < NB_ITEMS; k++){
+        for (unsigned int c = 0; c < knapsack.columns[k].size() && coefficient[k] > 0; c++){
+            cut += coefficient[k] * columns[knapsack.columns[k][c]];
+        }
+    }
+    return true;
+}
+
+/* Called by Cplex at each relaxation: adds the violated cover cuts. */
+void CoverCutCallback::invoke(const IloCplex::Callback::Context& context)
+{
+    if (context.getId() != IloCplex::Callback::Context::Id::Relaxation){
+        return;
+    }
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    bool root = (context.getLongInfo(IloCplex::Callback::Context::Info::NodeCount) == 0);
+    double objective = context.getRelaxationObjective();
+
+    IloNumArray values(env);
+    context.getRelaxationPoint(columns, values);
+    int added = 0;
+    for (unsigned int k = 0; k < knapsacks.size(); k++){
+        IloExpr cut(env);
+        double rhs = 0.0;
+        if (separate(knapsacks[k], values, cut, rhs)){
+            /* Covers only depend on the knapsack, not on the branching: the cuts are valid in the whole tree. */
+            context.addUserCut(IloRange(env, -IloInfinity, cut, rhs), IloCplex::UseCutPurge, IloFalse);
+            added++;
+        }
+        cut.end();
+    }
+    values.end();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    nbCalls++;
+    nbUserCuts += added;
+    if (root){
+        if (!rootSeen){
+            rootSeen = true;
+            rootBoundBefore = objective;
+        }
+        rootBoundAfter = objective;
+        nbRootCuts += added;
+    }
+    time += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/****************************************************************************************/
+/*										Destructors 									*/
+/****************************************************************************************/
+CoverCutCallback::~CoverCutCallback(){
+    columns.end();
+}
@@ -0,0 +1,115 @@
+#ifndef __callback__hpp
+#define __callback__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <chrono>
+#include <mutex>
+
+/*** Own Libraries ***/
+#include "model.hpp"
+
+/****************************************************************************************/
+/*										CONSTANTS										*/
+/****************************************************************************************/
+#define COVER_TOLERANCE 	1e-9 	// Relative excess of throughput over capacity for a set of demands to be a cover
+#define COVER_VIOLATION 	1e-3 	// Smallest violation of a cover cut worth adding
+
+
+/********************************************************************************************
+ * This structure stores one link capacity row seen as a knapsack: each demand using the link
+ * in at least one of its candidates is an item, whose weight is its throughput and whose
+ * value is the sum of its columns using the link (at most one of them is set).
+********************************************************************************************/
+struct Knapsack {
+	int 								link;		/**< Link id. **/
+	double 								capacity;	/**< Link capacity. **/
+	std::vector<int> 					demands;	/**< Demands using the link, by decreasing throughput. **/
+	std::vector<double> 				weights;	/**< Throughput of each demand. **/
+	std::vector<std::vector<int> > 		columns;	/**< Position in the callback columns of the z columns of each demand using the link. **/
+};
+
+/********************************************************************************************
+ * This class separates lifted cover inequalities on the link capacity rows, at the root and
+ * in the tree, through the Cplex generic callback. With throughputs and capacities several
+ * orders of magnitude apart, the LP relaxation of these knapsacks is weak: it may load a
+ * link with fractions of demands that cannot fit together. For each row whose fractional
+ * load exceeds the capacity, a cover is built greedily by increasing (1 - y) / throughput
+ * and made minimal, then every other demand of the row is lifted with the coefficients of
+ * Balas (h if its throughput is at least the h largest throughputs of the cover together).
+ * The counters are shared by the Cplex threads and guarded by a mutex.
+********************************************************************************************/
+class CoverCutCallback : public IloCplex::Callback::Function
+{
+	private:
+		const IloEnv&   				env;    		/**< IBM environment **/
+		IloNumVarArray 					columns;		/**< z columns of the handled demands, read at once from the relaxation. **/
+		std::vector<Knapsack> 			knapsacks;		/**< Capacity rows that a cover may violate. **/
+
+		std::mutex 						mutex;			/**< Guards the counters below. **/
+		int 							nbUserCuts;		/**< Number of cover cuts added. **/
+		int 							nbRootCuts;		/**< Number of cover cuts added at the root. **/
+		long 							nbCalls;		/**< Number of separation rounds. **/
+		double 							time;			/**< Time (in seconds) spent on separation, summed over threads. **/
+		bool 							rootSeen;		/**< True once the root relaxation has been separated. **/
+		double 							rootBoundBefore;/**< Root relaxation objective before the first cover cut. **/
+		double 							rootBoundAfter;	/**< Last root relaxation objective seen by the callback. **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. Gathers the capacity rows of the given demands that a cover may violate. **/
+		CoverCutCallback(const IloEnv& env, const Data& data, const std::vector<int>& demands, const IloNumVarMatrix& z);
+		CoverCutCallback(const IloEnv& env, const Data&&, const std::vector<int>& demands, const IloNumVarMatrix& z) = delete;
+		CoverCutCallback() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns the number of cover cuts added. **/
+		int getNbUserCuts() const { return nbUserCuts; }
+
+		/** Returns the number of cover cuts added at the root. **/
+		int getNbRootCuts() const { return nbRootCuts; }
+
+		/** Returns the number of separation rounds. **/
+		long getNbCalls() const { return nbCalls; }
+
+		/** Returns the time (in seconds) spent on separation, summed over threads. **/
+		double getTime() const { return time; }
+
+		/** Returns true once the root relaxation has been separated. **/
+		bool isRootSeen() const { return rootSeen; }
+
+		/** Returns the root relaxation objective before the first cover cut. **/
+		double getRootBoundBefore() const { return rootBoundBefore; }
+
+		/** Returns the last root relaxation objective seen by the callback. **/
+		double getRootBoundAfter() const { return rootBoundAfter; }
+
+		/** Returns the number of capacity rows watched by the callback. **/
+		int getNbKnapsacks() const { return knapsacks.size(); }
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Separates a lifted cover inequality on the given row. Returns false if none is violated by the given point. **/
+		bool separate(const Knapsack& knapsack, const IloNumArray& values, IloExpr& cut, double& rhs) const;
+
+		/** Called by Cplex at each relaxation: adds the violated cover cuts. **/
+		void invoke(const IloCplex::Callback::Context& context);
+
+	/****************************************************************************************/
+	/*										Destructors 									*/
+	/****************************************************************************************/
+		/** Destructor. Free dynamic allocated memory. **/
+		~CoverCutCallback();
+};
+
+
+#endif
@@ -0,0 +1,305 @@
+#include "decomposition.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+Decomposition::Decomposition(const Data& data_) : data(data_), nextComponent(0), nbSkipped(0), nbWorkers(1), nbThreadsPerModel(1), time(0.0)
+{
+    std::cout << "=> Decomposing instance ... " << std::endl;
+    const int NB_DEMANDS = data.getNbDemands();
+
+    /* Union-find over demands: all the demands using an active link are merged with the first one seen on it. */
+    std::vector<int> parent(NB_DEMANDS);
+    for (int i = 0; i < NB_DEMANDS; i++){
+        parent[i] = i;
+    }
+    std::function<int(int)> find = [&](int i){
+        while (parent[i] != i){
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    };
+    std::vector<int> firstUser(data.getNbLinks(), -1);
+    for (int i = 0; i < NB_DEMANDS; i++){
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            const std::vector<int>& links = candidates[c].getListOfLinks();
+            for (unsigned int l = 0; l < links.size(); l++){
+                if (!data.isCapacityActive(links[l])){
+                    continue;
+                }
+                if (firstUser[links[l]] < 0){
+                    firstUser[links[l]] = i;
+                }
+                else{
+                    parent[find(i)] = find(firstUser[links[l]]);
+                }
+            }
+        }
+    }
+
+    /* Components are sorted by decreasing size so that the largest ones start first. */
+    std::vector<int> index(NB_DEMANDS, -1);
+    for (int i = 0; i < NB_DEMANDS; i++){
+        int root = find(i);
+        if (index[root] < 0){
+            index[root] = components.size();
+            components.push_back(std::vector<int>());
+        }
+        components[index[root]].push_back(i);
+    }
+    std::stable_sort(components.begin(), components.end(), [](const std::vector<int> &a, const std::vector<int> &b){
+        return a.size() > b.size();
+    });
+
+    /* Cores are shared among the components solved at the same time. */
+    int nbThreads = data.getInput().getNbThreads();
+    if (nbThreads <= 0){
+        nbThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    nbWorkers = std::max(1, std::min(nbThreads, (int)components.size()));
+    nbThreadsPerModel = std::max(1, nbThreads / nbWorkers);
+
+    std::cout << "\t " << components.size() << " independent component(s) found";
+    if (!components.empty()){
+        std::cout << ", the largest one with " << components[0].size() << " demand(s)";
+    }
+    std::cout << "." << std::endl;
+}
+
+/****************************************************************************************/
+/*										Getters											*/
+/****************************************************************************************/
+
+/* Returns the merged status. */
+IloAlgorithm::Status Decomposition::getStatus() const
+{
+    bool optimal = true, feasible = true;
+    for (unsigned int k = 0; k < results.size(); k++){
+        if (results[k].status == IloAlgorithm::Infeasible || results[k].status == IloAlgorithm::InfeasibleOrUnbounded){
+            return IloAlgorithm::Infeasible;
+        }
+        if (results[k].status != IloAlgorithm::Optimal){
+            optimal = false;
+        }
+        if (!results[k].hasSolution){
+            feasible = false;
+        }
+    }
+    if (optimal){
+        return IloAlgorithm::Optimal;
+    }
+    return feasible ? IloAlgorithm::Feasible : IloAlgorithm::Unknown;
+}
+
+/* Returns the sum of the objective values of the components. */
+double Decomposition::getObjValue() const
+{
+    double objective = 0.0;
+    for (unsigned int k = 0; k < results.size(); k++){
+        objective += results[k].objective;
+    }
+    return objective;
+}
+
+/* Returns the sum of the lower bounds of the components. */
+double Decomposition::getBestObjValue() const
+{
+    double bound = 0.0;
+    for (unsigned int k = 0; k < results.size(); k++){
+        bound += results[k].bound;
+    }
+    return bound;
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Solves a component made of a single demand. */
+void Decomposition::solveSingleDemand(const int k)
+{
+    ComponentResult& result = results[k];
+    int i = components[k][0];
+    const std::vector<Candidate>& candidates = data.getCandidates(i);
+    double throughput = data.getDemand(i).getThroughput();
+    for (unsigned int c = 0; c < candidates.size(); c++){
+        bool fits = true;
+        const std::vector<int>& links = candidates[c].getListOfLinks();
+        for (unsigned int l = 0; l < links.size() && fits; l++){
+            fits = (throughput <= data.getLink(links[l]).getCapacity());
+        }
+        if (fits && (placement[i] < 0 || candidates[c].getCost() < candidates[placement[i]].getCost())){
+            placement[i] = c;
+        }
+    }
+    result.hasSolution = (placement[i] >= 0);
+    result.status = result.hasSolution ? IloAlgorithm::Optimal : IloAlgorithm::Infeasible;
+    result.objective = result.bound = result.hasSolution ? candidates[placement[i]].getCost() : 0.0;
+}
+
+/* Builds and solves the model of the given component. */
+void Decomposition::solveComponent(const int k)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    ComponentResult& result = results[k];
+    result.status = IloAlgorithm::Unknown;
+    result.objective = result.bound = 0.0;
+    result.nbNodes = result.nbNodesLeft = 0;
+    result.hasSolution = false;
+    result.time = 0.0;
+    if (components[k].size() == 1){
+        solveSingleDemand(k);
+        result.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return;
+    }
+    double remaining = std::chrono::duration<double>(deadline - start).count();
+    if (remaining <= 0.0){
+        nbSkipped++;
+        return;
+    }
+
+    /* Each component lives in its own environment so that threads share no Concert object. */
+    IloEnv env;
+    try
+    {
+        Model model(env, data, components[k]);
+        model.setThreads(nbThreadsPerModel);
+        model.setTimeLimit(remaining);
+        model.setExportFile("");
+        if (nbWorkers > 1){
+            model.setQuiet();
+        }
+        if (!mipStart.empty()){
+            model.setMipStart(mipStart);
+        }
+        model.run();
+
+        const IloCplex& cplex = model.getCplex();
+        result.status = cplex.getStatus();
+        result.hasSolution = (result.status == IloAlgorithm::Optimal || result.status == IloAlgorithm::Feasible);
+        if (result.hasSolution){
+            result.objective = model.getObjValue();
+            result.bound = model.getBestObjValue();
+            result.nbNodes = cplex.getNnodes();
+            result.nbNodesLeft = cplex.getNnodesLeft();
+            std::vector<int> chosen = model.getPlacement();
+            for (unsigned int d = 0; d < components[k].size(); d++){
+                placement[components[k][d]] = chosen[components[k][d]];
+            }
+        }
+    }
+    catch (const IloException& e) { std::cerr << "Exception caught on component " << k + 1 << ": " << e << std::endl; result.status = IloAlgorithm::Error; }
+    catch (...) { std::cerr << "Unknown exception caught on component " << k + 1 << "!" << std::endl; result.status = IloAlgorithm::Error; }
+    env.end();
+    result.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* Main loop of a worker thread. */
+void Decomposition::work()
+{
+    int k = nextComponent.fetch_add(1);
+    while (k < (int)components.size()){
+        solveComponent(k);
+        k = nextComponent.fetch_add(1);
+    }
+}
+
+/* Solves every component. */
+void Decomposition::run()
+{
+    std::cout << "=> Solving " << components.size() << " component(s) on " << nbWorkers << " worker(s) with "
+              << nbThreadsPerModel << " Cplex thread(s) each ..." << std::endl;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    results.assign(components.size(), ComponentResult());
+    placement.assign(data.getNbDemands(), -1);
+    nextComponent = 0;
+    nbSkipped = 0;
+    deadline = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(data.getInput().getTimeLimit()));
+
+    std::vector<std::thread> workers;
+    for (int w = 0; w < nbWorkers; w++){
+        workers.push_back(std::thread(&Decomposition::work, this));
+    }
+    for (int w = 0; w < nbWorkers; w++){
+        workers[w].join();
+    }
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (nbSkipped > 0){
+        std::cout << "\t Time limit reached: " << nbSkipped << " component(s) left unsolved." << std::endl;
+    }
+}
+
+/* Displays the obtained results. */
+void Decomposition::printResult()
+{
+    std::cout << "=> Printing solution ..." << std::endl;
+    for (int i = 0; i < data.getNbDemands(); i++){
+        std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
+        std::cout << "Placement for demand " << data.getDemand(i).getName() << " is : ";
+        if (placement[i] >= 0){
+            const Candidate& candidate = data.getCandidates(i)[placement[i]];
+            std::cout << "(" << data.getNode(candidate.getDU()).getName() << "," << data.getNode(candidate.getCU()).getName() << ")" << ", ";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
+
+    double largest = 0.0;
+    long nbNodes = 0;
+    for (unsigned int k = 0; k < results.size(); k++){
+        largest = std::max(largest, results[k].time);
+        nbNodes += results[k].nbNodes;
+    }
+    std::cout << "Status: " << getStatus() << std::endl;
+    std::cout << "Objective value: " << getObjValue() << std::endl;
+    std::cout << "Best bound: " << getBestObjValue() << std::endl;
+    std::cout << "Components: " << components.size() << std::endl;
+    std::cout << "Nodes evaluated: " << nbNodes << std::endl;
+    std::cout << "Largest component time: " << largest << std::endl;
+    std::cout << "Total time: " << time << std::endl << std::endl;
+}
+
+/* Outputs the obtained results. */
+void Decomposition::output()
+{
+    std::string output_file = data.getInput().getOutputFile();
+    if (output_file.empty()){
+        return;
+    }
+
+    std::ofstream fileReport(output_file, std::ios_base::app); // File report
+    // If file_output can't be opened
+    if(!fileReport)
+    {
+        std::cerr << "ERROR: Unable to access output file." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::string demand_name = getInBetweenString(data.getInput().getDemandFile(), "/", ".");
+    std::string node_name = getInBetweenString(data.getInput().getNodeFile(), "/", ".");
+    std::string instance_name = node_name + "_" + demand_name;
+
+    double objective = getObjValue();
+    double bound = getBestObjValue();
+    double gap = (std::fabs(objective) > 0.0) ? std::fabs(objective - bound) / std::fabs(objective) : 0.0;
+    long nbNodes = 0, nbNodesLeft = 0;
+    for (unsigned int k = 0; k < results.size(); k++){
+        nbNodes += results[k].nbNodes;
+        nbNodesLeft += results[k].nbNodesLeft;
+    }
+
+    fileReport << instance_name << ";"
+               << time << ";"
+               << objective << ";"
+               << bound << ";"
+               << gap*100 << ";"
+               << nbNodes << ";"
+               << nbNodesLeft*0.001 << ";"
+               << std::endl;
+
+    // Finalization ***
+    fileReport.close();
+}
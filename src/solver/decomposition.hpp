@@ -0,0 +1,116 @@
+#ifndef __decomposition__hpp
+#define __decomposition__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+/*** Own Libraries ***/
+#include "model.hpp"
+
+
+/********************************************************************************************
+ * This structure stores the outcome of the solve of one component.
+********************************************************************************************/
+struct ComponentResult {
+	IloAlgorithm::Status 	status;			/**< Cplex status at the end of the solve. **/
+	double 					objective;		/**< Cost of the best placement found. **/
+	double 					bound;			/**< Best lower bound. **/
+	long 					nbNodes;		/**< Number of branch-and-bound nodes evaluated. **/
+	long 					nbNodesLeft;	/**< Number of open nodes left. **/
+	double 					time;			/**< Time (in seconds) spent on building and solving the component. **/
+	bool 					hasSolution;	/**< True if a placement was found. **/
+};
+
+/********************************************************************************************
+ * This class splits the instance into independent subproblems and solves each of them as
+ * its own Model. Two demands interact when some of their candidates use a common link whose
+ * capacity row is active: connected components of this interaction graph share no capacity
+ * row and can be solved separately. Components are dispatched to a pool of threads, each
+ * one building its Model in its own IloEnv, and the placements are merged afterwards.
+ * Components made of a single demand are solved directly, without building a model. The
+ * time limit is a budget for the whole run: each component gets the time left, and the
+ * components whose model is not started by then are left unsolved.
+********************************************************************************************/
+class Decomposition
+{
+	private:
+		const Data&     					data;   			/**< Data read in data.hpp **/
+		std::vector<std::vector<int> > 		components;			/**< Demands of each component, largest first. **/
+		std::vector<ComponentResult> 		results;			/**< Outcome of each component. **/
+		std::vector<int> 					placement;			/**< Chosen candidate of each demand (-1 if none). **/
+		std::vector<int> 					mipStart;			/**< Placement installed as MIP start in each component (empty if none). **/
+		std::atomic<int> 					nextComponent;		/**< Next component to be dispatched. **/
+		std::atomic<int> 					nbSkipped;			/**< Number of components left unsolved because the time budget ran out. **/
+		int 								nbWorkers;			/**< Number of components solved at the same time. **/
+		int 								nbThreadsPerModel;	/**< Number of Cplex threads given to each component. **/
+		double 								time;				/**< Wall time (in seconds) spent on solving every component. **/
+		std::chrono::steady_clock::time_point deadline;		/**< End of the time budget shared by the components. **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. Builds the interaction graph and its connected components. **/
+		Decomposition(const Data& data);
+		Decomposition(const Data&&) = delete;
+		Decomposition() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns the number of components. **/
+		int getNbComponents() const { return components.size(); }
+
+		/** Returns the demands of each component. **/
+		const std::vector<std::vector<int> >& getComponents() const { return components; }
+
+		/** Returns the chosen candidate of each demand (-1 if none). **/
+		const std::vector<int>& getPlacement() const { return placement; }
+
+		/** Returns the merged status: optimal if every component is, infeasible if some component is. **/
+		IloAlgorithm::Status getStatus() const;
+
+		/** Returns the sum of the objective values of the components. **/
+		double getObjValue() const;
+
+		/** Returns the sum of the lower bounds of the components. **/
+		double getBestObjValue() const;
+
+	/****************************************************************************************/
+	/*										Setters											*/
+	/****************************************************************************************/
+		/** Sets the placement (chosen candidate of each demand, -1 if none) installed as MIP start in each component. **/
+		void setMipStart(const std::vector<int>& placement) { mipStart = placement; }
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Solves a component made of a single demand by picking its cheapest candidate that fits the link capacities. **/
+		void solveSingleDemand(const int k);
+
+		/** Builds and solves the model of the given component within the time left before the deadline. **/
+		void solveComponent(const int k);
+
+		/** Main loop of a worker thread: solves components until none is left. **/
+		void work();
+
+		/** Solves every component. **/
+		void run();
+
+		/** Displays the obtained results **/
+		void printResult();
+
+		/** Outputs the obtained results **/
+		void output();
+};
+
+
+#endif
@@ -0,0 +1,331 @@
+#include "diving.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+Diving::Diving(const Data& data_) : data(data_), nbDives(data_.getInput().getNbDives()), nbThreads(1),
+                solved(false), lpValue(0.0), lpTime(0.0), cost(0.0), bestDive(-1), nbFeasible(0), time(0.0)
+{
+    nbThreads = data.getInput().getNbThreads();
+    if (nbThreads <= 0){
+        nbThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    nbThreads = std::max(1, std::min(nbThreads, nbDives));
+}
+
+/****************************************************************************************/
+/*										Getters											*/
+/****************************************************************************************/
+
+/* Returns the relative gap between the best placement and the relaxation. */
+double Diving::getRelativeGap() const
+{
+    if (!hasSolution()){
+        return DBL_MAX;
+    }
+    return std::max(0.0, cost - lpValue) / std::max(1.0, std::fabs(cost));
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Solves the linear relaxation with the LP solver of the parameters. */
+void Diving::solveRelaxation()
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (data.getInput().getLpSolver() == "native"){
+        FirstOrderSolver lp(data);
+        lp.run();
+        solved = (lp.getLowerBound() > -DBL_MAX && lp.getLowerBound() < DBL_MAX);
+        if (solved){
+            fractional.resize(data.getNbDemands());
+            for (int i = 0; i < data.getNbDemands(); i++){
+                for (unsigned int c = 0; c < data.getCandidates(i).size(); c++){
+                    fractional[i].push_back(lp.getAssignment(i, c));
+                }
+            }
+            lpValue = lp.getLowerBound();
+        }
+    }
+    else{
+        /* The relaxation lives in its own environment: the model solved afterwards is built as usual. */
+        IloEnv env;
+        try
+        {
+            Model model(env, data);
+            model.setExportFile("");
+            solved = model.solveRelaxation(fractional, lpValue);
+        }
+        catch (const IloException& e) { std::cerr << "Exception caught: " << e << std::endl; solved = false; }
+        catch (...) { std::cerr << "Unknown exception caught!" << std::endl; solved = false; }
+        env.end();
+    }
+    lpTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    confidence.assign(data.getNbDemands(), 0.0);
+    if (solved){
+        for (int i = 0; i < data.getNbDemands(); i++){
+            for (unsigned int c = 0; c < fractional[i].size(); c++){
+                confidence[i] = std::max(confidence[i], fractional[i][c]);
+            }
+        }
+    }
+}
+
+/* Runs the dives of index t, t + nbThreads, ... and keeps the best one. */
+void Diving::work(const int t, DivingResult& result) const
+{
+    result.placement.clear();
+    result.cost = DBL_MAX;
+    result.dive = -1;
+    result.nbFeasible = 0;
+    std::vector<int> choice;
+    double total = 0.0;
+    for (int d = t; d < nbDives; d += nbThreads){
+        if (dive(d, choice, total)){
+            result.nbFeasible++;
+            if (total < result.cost){
+                result.placement = choice;
+                result.cost = total;
+                result.dive = d;
+            }
+        }
+    }
+}
+
+/* Runs one dive. */
+bool Diving::dive(const int d, std::vector<int>& choice, double& total) const
+{
+    const int NB_DEMANDS = data.getNbDemands();
+    std::mt19937 generator(DIVING_SEED + d);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    double noise = (d == 0 ? 0.0 : DIVING_ORDER_NOISE);
+    double exploration = (d == 0 ? 0.0 : DIVING_EXPLORATION);
+
+    /* Demands the LP is most sure about are fixed first, larger throughputs breaking ties. */
+    std::vector<double> key(NB_DEMANDS);
+    std::vector<int> order(NB_DEMANDS);
+    for (int i = 0; i < NB_DEMANDS; i++){
+        key[i] = confidence[i] + noise*uniform(generator);
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](const int a, const int b){
+        if (key[a] != key[b]){
+            return key[a] > key[b];
+        }
+        return data.getDemand(a).getThroughput() > data.getDemand(b).getThroughput();
+    });
+
+    std::vector<double> residual(data.getNbLinks());
+    for (int l = 0; l < data.getNbLinks(); l++){
+        residual[l] = data.getLink(l).getCapacity();
+    }
+    choice.assign(NB_DEMANDS, -1);
+    total = 0.0;
+    std::vector<int> fitting;
+    for (int n = 0; n < NB_DEMANDS; n++){
+        int i = order[n];
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+
+        /* Candidates that no longer fit are out: this is where the earlier fixings propagate. */
+        fitting.clear();
+        double mass = 0.0;
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            if (fits(i, c, residual)){
+                fitting.push_back(c);
+                mass += fractional[i][c] + exploration;
+            }
+        }
+        if (fitting.empty()){
+            return false;
+        }
+
+        /* Randomized rounding among the fitting candidates; the first dive takes the largest value, the cheapest on ties. */
+        int chosen = fitting[0];
+        if (d == 0 || mass <= 0.0){
+            for (unsigned int f = 1; f < fitting.size(); f++){
+                int c = fitting[f];
+                if (fractional[i][c] > fractional[i][chosen] + EPSILON
+                    || (fractional[i][c] > fractional[i][chosen] - EPSILON && candidates[c].getCost() < candidates[chosen].getCost())){
+                    chosen = c;
+                }
+            }
+        }
+        else{
+            double draw = mass*uniform(generator);
+            for (unsigned int f = 0; f < fitting.size(); f++){
+                chosen = fitting[f];
+                draw -= fractional[i][chosen] + exploration;
+                if (draw <= 0.0){
+                    break;
+                }
+            }
+        }
+
+        const std::vector<int>& links = candidates[chosen].getListOfLinks();
+        for (unsigned int l = 0; l < links.size(); l++){
+            residual[links[l]] -= data.getDemand(i).getThroughput();
+        }
+        choice[i] = chosen;
+        total += candidates[chosen].getCost();
+    }
+    improve(choice, residual, total);
+    return true;
+}
+
+/* Returns true if the c-th candidate of demand i fits the residual capacities. */
+bool Diving::fits(const int i, const int c, const std::vector<double>& residual) const
+{
+    double throughput = data.getDemand(i).getThroughput();
+    const std::vector<int>& links = data.getCandidates(i)[c].getListOfLinks();
+    for (unsigned int l = 0; l < links.size(); l++){
+        /* Capacity rows proven redundant by presolve cannot be violated. */
+        if (!data.isCapacityActive(links[l])){
+            continue;
+        }
+        if (throughput > residual[links[l]] + DIVING_CAPACITY_TOLERANCE*data.getLink(links[l]).getCapacity()){
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Moves each demand to its cheapest candidate that fits the residual capacities. */
+void Diving::improve(std::vector<int>& choice, std::vector<double>& residual, double& total) const
+{
+    /* A move frees capacity for the demands visited before it, so passes are repeated while some demand moves. */
+    bool moved = true;
+    for (int pass = 0; pass < DIVING_MAX_PASSES && moved; pass++){
+        moved = false;
+        for (int i = 0; i < data.getNbDemands(); i++){
+            const std::vector<Candidate>& candidates = data.getCandidates(i);
+            double throughput = data.getDemand(i).getThroughput();
+            int current = choice[i];
+
+            /* The demand is taken out, so that its own throughput is available to its other candidates. */
+            const std::vector<int>& links = candidates[current].getListOfLinks();
+            for (unsigned int l = 0; l < links.size(); l++){
+                residual[links[l]] += throughput;
+            }
+            int best = current;
+            for (unsigned int c = 0; c < candidates.size(); c++){
+                if (candidates[c].getCost() < candidates[best].getCost() && fits(i, c, residual)){
+                    best = c;
+                }
+            }
+            const std::vector<int>& chosen = candidates[best].getListOfLinks();
+            for (unsigned int l = 0; l < chosen.size(); l++){
+                residual[chosen[l]] -= throughput;
+            }
+            if (best != current){
+                total += candidates[best].getCost() - candidates[current].getCost();
+                choice[i] = best;
+                moved = true;
+            }
+        }
+    }
+}
+
+/* Solves the relaxation and runs the dives. */
+void Diving::run()
+{
+    std::cout << "=> Running LP-guided dives ..." << std::endl;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    solveRelaxation();
+    if (!solved){
+        std::cout << "\t The relaxation was not solved to optimality: no dive is run." << std::endl;
+        time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return;
+    }
+
+    std::vector<DivingResult> results(nbThreads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < nbThreads; t++){
+        threads.push_back(std::thread(&Diving::work, this, t, std::ref(results[t])));
+    }
+    for (int t = 0; t < nbThreads; t++){
+        threads[t].join();
+    }
+
+    /* Ties are broken by dive index, so that the result does not depend on the number of threads. */
+    for (int t = 0; t < nbThreads; t++){
+        nbFeasible += results[t].nbFeasible;
+        if (results[t].dive < 0){
+            continue;
+        }
+        if (bestDive < 0 || results[t].cost < cost || (results[t].cost == cost && results[t].dive < bestDive)){
+            placement = results[t].placement;
+            cost = results[t].cost;
+            bestDive = results[t].dive;
+        }
+    }
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "\t Relaxation value " << lpValue << " in " << lpTime << " seconds, " << nbFeasible << " of " << nbDives << " dives placed every demand";
+    if (hasSolution()){
+        std::cout << ", best cost " << cost << " (dive " << bestDive << ", gap " << getRelativeGap()*100 << "%)";
+    }
+    std::cout << "." << std::endl;
+    std::cout << "=> Dives done in " << time << " seconds." << std::endl;
+}
+
+/* Displays the obtained results. */
+void Diving::printResult()
+{
+    std::cout << "=> Printing solution ..." << std::endl;
+    if (!hasSolution()){
+        std::cout << "No placement found by the dives." << std::endl;
+    }
+    else{
+        for (int i = 0; i < data.getNbDemands(); i++) {
+            const Candidate& candidate = data.getCandidates(i)[placement[i]];
+            std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
+            std::cout << "Placement for demand " << data.getDemand(i).getName() << " is : "
+                      << "(" << data.getNode(candidate.getDU()).getName() << "," << data.getNode(candidate.getCU()).getName() << ")" << std::endl;
+        }
+        std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
+        std::cout << "Objective value: " << cost << std::endl;
+    }
+    std::cout << "LP value: " << lpValue << std::endl;
+    std::cout << "Dives: " << nbFeasible << " of " << nbDives << " feasible" << std::endl;
+    std::cout << "Total time: " << time << std::endl << std::endl;
+}
+
+/* Outputs the obtained results. */
+void Diving::output()
+{
+    std::string output_file = data.getInput().getOutputFile();
+    if (output_file.empty()){
+        return;
+    }
+
+	std::ofstream fileReport(output_file, std::ios_base::app); // File report
+    // If file_output can't be opened
+    if(!fileReport)
+    {
+        std::cerr << "ERROR: Unable to access output file." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::string demand_name = getInBetweenString(data.getInput().getDemandFile(), "/", ".");
+    std::string node_name = getInBetweenString(data.getInput().getNodeFile(), "/", ".");
+    std::string instance_name = node_name + "_" + demand_name;
+
+    fileReport << instance_name << ";"
+    		   << time << ";";
+    if (hasSolution()){
+        fileReport << cost << ";"
+                   << lpValue << ";"
+                   << getRelativeGap()*100 << ";";
+    }
+    else{
+        fileReport << "Unknown;"
+                   << lpValue << ";"
+                   << ";";
+    }
+    fileReport << nbFeasible << ";"
+               << nbDives << ";"
+               << std::endl;
+    fileReport.close();
+}
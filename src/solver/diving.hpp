@@ -0,0 +1,131 @@
+#ifndef __diving__hpp
+#define __diving__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <chrono>
+#include <random>
+#include <thread>
+
+/*** Own Libraries ***/
+#include "model.hpp"
+#include "firstorder.hpp"
+
+/****************************************************************************************/
+/*										CONSTANTS										*/
+/****************************************************************************************/
+#define DIVING_SEED 				1 		// Seed of the first dive, the d-th dive uses DIVING_SEED + d
+#define DIVING_ORDER_NOISE 			0.3 	// Largest random perturbation of the LP confidence used to order the demands
+#define DIVING_EXPLORATION 			1e-2 	// Weight added to the LP value of each candidate in randomized rounding
+#define DIVING_CAPACITY_TOLERANCE 	1e-9 	// Relative tolerance used when checking link capacities
+#define DIVING_MAX_PASSES 			10 		// Maximum number of improvement passes over the demands after a dive
+
+
+/********************************************************************************************
+ * This structure stores the best placement found by one diving thread.
+********************************************************************************************/
+struct DivingResult {
+	std::vector<int> 	placement;		/**< Chosen candidate of each demand (empty if no dive succeeded). **/
+	double 				cost;			/**< Cost of the placement. **/
+	int 				dive;			/**< Index of the dive that found the placement (-1 if none). **/
+	int 				nbFeasible;		/**< Number of dives of the thread that placed every demand. **/
+};
+
+/********************************************************************************************
+ * This class turns the linear relaxation into placements without Cplex. The relaxation is
+ * solved once, by Cplex on the Model (the z columns relaxed in place) or by the native
+ * first-order solver (lpSolver=native). Then many dives run on several threads: each one
+ * orders the demands by how sure the LP is about them (the largest z value, randomly
+ * perturbed) and fixes them one at a time, drawing a candidate with probability given by
+ * its z value among the candidates that still fit the residual link capacities. Fixing a
+ * demand consumes its throughput on the links of the candidate, so that later demands only
+ * see the capacity left. A dive that completes is improved by moving each demand to its
+ * cheapest candidate that fits. The first dive is deterministic (plain LP rounding) and the
+ * d-th one is seeded with DIVING_SEED + d, so the result does not depend on the number of
+ * threads. The best placement is a MIP start, or the answer of a relaxation run.
+********************************************************************************************/
+class Diving
+{
+	private:
+		const Data&     					data;   		/**< Data read in data.hpp **/
+		int 								nbDives;		/**< Number of dives to be run. **/
+		int 								nbThreads;		/**< Number of threads running the dives. **/
+
+		/*** Relaxation ***/
+		std::vector<std::vector<double> > 	fractional;		/**< LP value of each candidate of each demand. **/
+		std::vector<double> 				confidence;		/**< Largest LP value among the candidates of each demand. **/
+		bool 								solved;			/**< True if the relaxation was solved to optimality. **/
+		double 								lpValue;		/**< Value of the relaxation, a lower bound on the placement cost. **/
+		double 								lpTime;			/**< Time (in seconds) spent on the relaxation. **/
+
+		/*** Results ***/
+		std::vector<int> 					placement;		/**< Chosen candidate of each demand in the best placement (empty if none). **/
+		double 								cost;			/**< Cost of the best placement. **/
+		int 								bestDive;		/**< Index of the dive that found the best placement (-1 if none). **/
+		int 								nbFeasible;		/**< Number of dives that placed every demand. **/
+		double 								time;			/**< Time (in seconds) spent on the relaxation and the dives. **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. @param data The data of the instance. **/
+		Diving(const Data& data);
+		Diving(const Data&&) = delete;
+		Diving() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns true if some dive placed every demand. **/
+		bool hasSolution() const { return !placement.empty(); }
+
+		/** Returns the chosen candidate of each demand in the best placement (empty if none). **/
+		const std::vector<int>& getPlacement() const { return placement; }
+
+		/** Returns the cost of the best placement. **/
+		const double& getCost() const { return cost; }
+
+		/** Returns the value of the relaxation. **/
+		const double& getLpValue() const { return lpValue; }
+
+		/** Returns the relative gap between the best placement and the relaxation. **/
+		double getRelativeGap() const;
+
+		/** Returns the time (in seconds) spent on the relaxation and the dives. **/
+		const double& getTime() const { return time; }
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Solves the linear relaxation with the LP solver of the parameters. **/
+		void solveRelaxation();
+
+		/** Runs the dives of index t, t + nbThreads, ... and keeps the best one. @param t The thread index. @param result The best placement of the thread. **/
+		void work(const int t, DivingResult& result) const;
+
+		/** Runs one dive. Returns true if every demand was placed. @param d The dive index. @param choice Filled with the chosen candidate of each demand. @param total Filled with the cost of the placement. **/
+		bool dive(const int d, std::vector<int>& choice, double& total) const;
+
+		/** Returns true if the c-th candidate of demand i fits the residual capacities. **/
+		bool fits(const int i, const int c, const std::vector<double>& residual) const;
+
+		/** Moves each demand to its cheapest candidate that fits the residual capacities. **/
+		void improve(std::vector<int>& choice, std::vector<double>& residual, double& total) const;
+
+		/** Solves the relaxation and runs the dives. **/
+		void run();
+
+		/** Displays the obtained results **/
+		void printResult();
+
+		/** Outputs the obtained results **/
+		void output();
+};
+
+
+#endif
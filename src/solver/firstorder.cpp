@@ -0,0 +1,332 @@
+#include "firstorder.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+FirstOrderSolver::FirstOrderSolver(const Data& data_) :
+                data(data_), nbThreads(1), costScale(1.0), throughputScale(1.0),
+                lowerBound(-DBL_MAX), primalValue(DBL_MAX), maxViolation(0.0), nbIterations(0), time(0.0)
+{
+    std::cout << "=> Building first-order relaxation solver ... " << std::endl;
+    nbThreads = data.getInput().getNbThreads();
+    if (nbThreads <= 0){
+        nbThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    /* Scaling: costs and throughputs are brought close to 1 so that multipliers are of order 1. */
+    const int NB_DEMANDS = data.getNbDemands();
+    for (int i = 0; i < NB_DEMANDS; i++){
+        throughputScale = std::max(throughputScale, data.getDemand(i).getThroughput());
+        for (unsigned int c = 0; c < data.getCandidates(i).size(); c++){
+            costScale = std::max(costScale, std::fabs(data.getCandidates(i)[c].getCost()));
+        }
+    }
+
+    /* Only links used by some candidate carry a multiplier. */
+    std::vector<int> activeIndex(data.getNbLinks(), -1);
+    candidateStart.push_back(0);
+    linkStart.push_back(0);
+    for (int i = 0; i < NB_DEMANDS; i++){
+        throughput.push_back(data.getDemand(i).getThroughput() / throughputScale);
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            candidateCost.push_back(candidates[c].getCost() / costScale);
+            for (unsigned int l = 0; l < candidates[c].getListOfLinks().size(); l++){
+                int link = candidates[c].getListOfLinks()[l];
+                /* Capacity rows proven redundant by presolve carry no multiplier. */
+                if (!data.isCapacityActive(link)){
+                    continue;
+                }
+                if (activeIndex[link] < 0){
+                    activeIndex[link] = activeLinks.size();
+                    activeLinks.push_back(link);
+                    capacity.push_back(data.getLink(link).getCapacity() / throughputScale);
+                }
+                linkIndex.push_back(activeIndex[link]);
+            }
+            linkStart.push_back(linkIndex.size());
+        }
+        candidateStart.push_back(candidateCost.size());
+    }
+    std::cout << "\t " << candidateCost.size() << " columns and " << activeLinks.size() << " capacity rows." << std::endl;
+    std::cout << "=> First-order relaxation solver was correctly built ! " << std::endl;
+}
+
+/* Returns the dual multiplier of the capacity row of the given link (original units). */
+double FirstOrderSolver::getMultiplier(const int link) const
+{
+    for (unsigned int a = 0; a < activeLinks.size() && a < multiplier.size(); a++){
+        if (activeLinks[a] == link){
+            return multiplier[a];
+        }
+    }
+    return 0.0;
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Evaluates the demands in [first, last) at u. */
+void FirstOrderSolver::evaluateRange(const int first, const int last, const std::vector<double> &u, const double mu, std::vector<double> &gradient, double &smooth, double &exact, double &primal, std::vector<double> *z) const
+{
+    std::vector<double> reduced;
+    for (int i = first; i < last; i++){
+        /* Reduced cost of each candidate: placement cost plus the price of the capacity it consumes. */
+        int begin = candidateStart[i], end = candidateStart[i+1];
+        reduced.resize(end - begin);
+        double minReduced = DBL_MAX;
+        for (int c = begin; c < end; c++){
+            double price = 0.0;
+            for (int l = linkStart[c]; l < linkStart[c+1]; l++){
+                price += u[linkIndex[l]];
+            }
+            reduced[c - begin] = candidateCost[c] + throughput[i]*price;
+            minReduced = std::min(minReduced, reduced[c - begin]);
+        }
+        /* Softmin over the candidates gives the smoothed value and the fractional assignments. */
+        double sum = 0.0;
+        for (int c = begin; c < end; c++){
+            reduced[c - begin] = std::exp(-(reduced[c - begin] - minReduced) / mu);
+            sum += reduced[c - begin];
+        }
+        exact += minReduced;
+        smooth += minReduced - mu*std::log(sum);
+        for (int c = begin; c < end; c++){
+            double p = reduced[c - begin] / sum;
+            primal += p * candidateCost[c];
+            for (int l = linkStart[c]; l < linkStart[c+1]; l++){
+                gradient[linkIndex[l]] += throughput[i] * p;
+            }
+            if (z != NULL){
+                (*z)[c] = p;
+            }
+        }
+    }
+}
+
+/* Evaluates the smoothed dual function at u. */
+double FirstOrderSolver::evaluate(const std::vector<double> &u, const double mu, std::vector<double> &gradient, double &exact, double &primal, std::vector<double> *z) const
+{
+    const int NB_DEMANDS = data.getNbDemands();
+    const int NB_LINKS = activeLinks.size();
+    double smooth = 0.0;
+    exact = primal = 0.0;
+    gradient.assign(NB_LINKS, 0.0);
+    int nbChunks = std::min(nbThreads, std::max(1, NB_DEMANDS / 1000));
+    if (nbChunks <= 1){
+        evaluateRange(0, NB_DEMANDS, u, mu, gradient, smooth, exact, primal, z);
+    }
+    else{
+        /* Each thread accumulates the contribution of a block of demands, then blocks are summed. */
+        std::vector<std::vector<double> > gradients(nbChunks, std::vector<double>(NB_LINKS, 0.0));
+        std::vector<double> smooths(nbChunks, 0.0), exacts(nbChunks, 0.0), primals(nbChunks, 0.0);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < nbChunks; t++){
+            int first = (long)NB_DEMANDS * t / nbChunks;
+            int last = (long)NB_DEMANDS * (t + 1) / nbChunks;
+            threads.push_back(std::thread(&FirstOrderSolver::evaluateRange, this, first, last, std::cref(u), mu,
+                                          std::ref(gradients[t]), std::ref(smooths[t]), std::ref(exacts[t]), std::ref(primals[t]), z));
+        }
+        for (int t = 0; t < nbChunks; t++){
+            threads[t].join();
+            smooth += smooths[t];
+            exact += exacts[t];
+            primal += primals[t];
+            for (int l = 0; l < NB_LINKS; l++){
+                gradient[l] += gradients[t][l];
+            }
+        }
+    }
+    for (int l = 0; l < NB_LINKS; l++){
+        smooth -= u[l]*capacity[l];
+        exact -= u[l]*capacity[l];
+        gradient[l] -= capacity[l];
+    }
+    return smooth;
+}
+
+/* Solves the linear relaxation. */
+void FirstOrderSolver::run()
+{
+    std::cout << "=> Solving linear relaxation with the first-order solver ..." << std::endl;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    const double timeLimit = data.getInput().getTimeLimit();
+    const int NB_LINKS = activeLinks.size();
+
+    for (int i = 0; i < data.getNbDemands(); i++){
+        if (candidateStart[i] == candidateStart[i+1]){
+            std::cout << "\t Demand " << data.getDemand(i).getName() << " has no placement candidate: the relaxation is infeasible." << std::endl;
+            lowerBound = primalValue = DBL_MAX;
+            return;
+        }
+    }
+
+    std::vector<double> u(NB_LINKS, 0.0), y(NB_LINKS, 0.0), next(NB_LINKS, 0.0), bestU(NB_LINKS, 0.0);
+    std::vector<double> gradY, gradNext;
+    double mu = FO_INITIAL_SMOOTHING;
+    double lipschitz = 1.0 / mu;
+    double momentum = 1.0;
+    double previous = -DBL_MAX;
+    double best = -DBL_MAX, primal = DBL_MAX, violation = DBL_MAX;
+    int lastReduction = 0;
+
+    for (nbIterations = 1; nbIterations <= FO_MAX_ITERATIONS; nbIterations++){
+        double exactY, primalY;
+        double valueY = evaluate(y, mu, gradY, exactY, primalY, NULL);
+        if (exactY > best){
+            best = exactY;
+            bestU = y;
+        }
+
+        /* Projected gradient ascent step from y, with backtracking on the Lipschitz estimate. */
+        double valueNext, exactNext, primalNext;
+        while (true){
+            double linear = 0.0, squared = 0.0;
+            for (int l = 0; l < NB_LINKS; l++){
+                next[l] = std::max(0.0, y[l] + gradY[l] / lipschitz);
+                double d = next[l] - y[l];
+                linear += gradY[l]*d;
+                squared += d*d;
+            }
+            valueNext = evaluate(next, mu, gradNext, exactNext, primalNext, NULL);
+            if (valueNext >= valueY + linear - 0.5*lipschitz*squared - 1e-12*std::max(1.0, std::fabs(valueY))){
+                break;
+            }
+            lipschitz *= 2.0;
+        }
+        if (exactNext > best){
+            best = exactNext;
+            bestU = next;
+        }
+
+        /* Fractional assignments at the new point: cost and capacity violation. */
+        primal = primalNext;
+        violation = 0.0;
+        double mapping = 0.0;
+        for (int l = 0; l < NB_LINKS; l++){
+            violation = std::max(violation, gradNext[l] / std::max(capacity[l], FO_MIN_CAPACITY));
+            mapping = std::max(mapping, std::fabs(next[l] - y[l]) * lipschitz);
+        }
+        double gap = std::fabs(primal - best) / std::max(1.0, std::fabs(best));
+        if (gap <= FO_GAP_TOLERANCE && violation <= FO_FEASIBILITY_TOLERANCE){
+            u = next;
+            break;
+        }
+
+        /* Acceleration with adaptive restart whenever the dual value decreases. */
+        if (valueNext < previous){
+            momentum = 1.0;
+            y = next;
+        }
+        else{
+            double nextMomentum = (1.0 + std::sqrt(1.0 + 4.0*momentum*momentum)) / 2.0;
+            for (int l = 0; l < NB_LINKS; l++){
+                y[l] = std::max(0.0, next[l] + ((momentum - 1.0) / nextMomentum) * (next[l] - u[l]));
+            }
+            momentum = nextMomentum;
+        }
+        u = next;
+        previous = valueNext;
+        lipschitz *= 0.9;
+
+        /* Smoothing decreases once the current smoothed problem is nearly solved, or periodically. */
+        if (mu > FO_FINAL_SMOOTHING && (mapping <= mu || nbIterations - lastReduction >= FO_SMOOTHING_STEPS)){
+            mu = std::max(FO_FINAL_SMOOTHING, mu / 2.0);
+            lipschitz *= 2.0;
+            momentum = 1.0;
+            y = u;
+            previous = -DBL_MAX;
+            lastReduction = nbIterations;
+        }
+
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if (elapsed > timeLimit){
+            std::cout << "\t Time limit reached." << std::endl;
+            break;
+        }
+    }
+    nbIterations = std::min(nbIterations, FO_MAX_ITERATIONS);
+
+    /* Final fractional assignments, back in original units. */
+    std::vector<double> gradient;
+    double exact;
+    assignment.assign(candidateCost.size(), 0.0);
+    evaluate(u, mu, gradient, exact, primal, &assignment);
+    if (exact > best){
+        best = exact;
+        bestU = u;
+    }
+    violation = 0.0;
+    for (int l = 0; l < NB_LINKS; l++){
+        violation = std::max(violation, gradient[l] / std::max(capacity[l], FO_MIN_CAPACITY));
+    }
+    multiplier.resize(NB_LINKS);
+    for (int l = 0; l < NB_LINKS; l++){
+        multiplier[l] = bestU[l] * costScale / throughputScale;
+    }
+    lowerBound = best * costScale;
+    primalValue = primal * costScale;
+    maxViolation = std::max(0.0, violation);
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* Displays the obtained results. */
+void FirstOrderSolver::printResult()
+{
+    std::cout << "=> Printing solution ..." << std::endl;
+    if (lowerBound >= DBL_MAX){
+        std::cout << "The relaxation is infeasible." << std::endl;
+        return;
+    }
+    for (int i = 0; i < data.getNbDemands(); i++) {
+        std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
+        std::cout << "Fractional placement for demand " << data.getDemand(i).getName() << " is : ";
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            double value = getAssignment(i, c);
+            if (value > FO_DISPLAY_THRESHOLD){
+                std::cout << "(" << data.getNode(candidates[c].getDU()).getName() << "," << data.getNode(candidates[c].getCU()).getName() << ")=" << value << ", ";
+            }
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
+    std::cout << "Lower bound: " << lowerBound << std::endl;
+    std::cout << "Fractional assignment cost: " << primalValue << std::endl;
+    std::cout << "Max capacity violation: " << maxViolation*100 << "%" << std::endl;
+    std::cout << "Iterations: " << nbIterations << std::endl;
+    std::cout << "Total time: " << time << std::endl << std::endl;
+}
+
+/* Outputs the obtained results. */
+void FirstOrderSolver::output()
+{
+    std::string output_file = data.getInput().getOutputFile();
+    if (output_file.empty()){
+        return;
+    }
+
+	std::ofstream fileReport(output_file, std::ios_base::app); // File report
+    // If file_output can't be opened
+    if(!fileReport)
+    {
+        std::cerr << "ERROR: Unable to access output file." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::string demand_name = getInBetweenString(data.getInput().getDemandFile(), "/", ".");
+    std::string node_name = getInBetweenString(data.getInput().getNodeFile(), "/", ".");
+    std::string instance_name = node_name + "_" + demand_name;
+
+    fileReport << instance_name << ";"
+    		   << time << ";"
+    		   << primalValue << ";"
+    		   << lowerBound << ";"
+    		   << std::fabs(primalValue - lowerBound) / std::max(1.0, std::fabs(lowerBound))*100 << ";"
+    		   << nbIterations << ";"
+    		   << maxViolation << ";"
+               << std::endl;
+    fileReport.close();
+}
@@ -0,0 +1,116 @@
+#ifndef __firstorder__hpp
+#define __firstorder__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <chrono>
+#include <thread>
+
+/*** Own Libraries ***/
+#include "../instance/data.hpp"
+#include "../tools/others.hpp"
+
+/****************************************************************************************/
+/*										CONSTANTS										*/
+/****************************************************************************************/
+#define FO_MAX_ITERATIONS 		20000 		// Maximum number of gradient iterations
+#define FO_INITIAL_SMOOTHING 	1e-1 		// Initial entropy smoothing (relative to the largest placement cost)
+#define FO_FINAL_SMOOTHING 		1e-7 		// Final entropy smoothing (relative to the largest placement cost)
+#define FO_SMOOTHING_STEPS 		200 		// Number of iterations between two reductions of the smoothing
+#define FO_GAP_TOLERANCE 		1e-6 		// Relative gap between primal and dual values at which the solver stops
+#define FO_FEASIBILITY_TOLERANCE 1e-6 		// Relative capacity violation tolerated on the fractional assignments
+#define FO_MIN_CAPACITY 		1e-10 		// Scaled capacity below which violations are measured in absolute terms
+#define FO_DISPLAY_THRESHOLD 	1e-4 		// Fractional assignments below this value are not displayed
+
+
+/********************************************************************************************
+ * This class solves the linear relaxation of the placement problem with a first-order
+ * primal-dual method that exploits its structure: assignment rows summing to 1 for each
+ * demand and a few link capacity rows. The capacity rows are dualized and the dual function
+ * is smoothed with an entropy term, so that the fractional assignments of each demand are a
+ * softmin over its candidates. The smoothed dual is maximized by accelerated projected
+ * gradient with backtracking and adaptive restarts while the smoothing decreases. Every
+ * iterate gives a valid lower bound (the exact Lagrangian value) and fractional assignments
+ * whose cost and capacity violation are reported.
+********************************************************************************************/
+class FirstOrderSolver
+{
+	private:
+		const Data&     	data;   			/**< Data read in data.hpp **/
+		int 				nbThreads;			/**< Number of threads used for evaluating the dual function. **/
+
+		/*** Flat structure (scaled) ***/
+		double 				costScale;			/**< Placement costs are divided by this value. **/
+		double 				throughputScale;	/**< Throughputs and capacities are divided by this value. **/
+		std::vector<int> 	activeLinks;		/**< Ids of the links used by at least one candidate. **/
+		std::vector<double> capacity;			/**< Scaled capacity of each active link. **/
+		std::vector<double> throughput;			/**< Scaled throughput of each demand. **/
+		std::vector<int> 	candidateStart;		/**< Index of the first candidate of each demand (size: demands + 1). **/
+		std::vector<double> candidateCost;		/**< Scaled cost of each candidate. **/
+		std::vector<int> 	linkStart;			/**< Index of the first link of each candidate (size: candidates + 1). **/
+		std::vector<int> 	linkIndex;			/**< Active link index of each (candidate, link) pair. **/
+
+		/*** Results ***/
+		std::vector<double> multiplier;			/**< Best dual multipliers of the capacity rows (original units). **/
+		std::vector<double> assignment;			/**< Fractional assignment of each candidate. **/
+		double 				lowerBound;			/**< Best lower bound on the LP value. **/
+		double 				primalValue;		/**< Cost of the fractional assignments. **/
+		double 				maxViolation;		/**< Largest relative capacity violation of the fractional assignments. **/
+		int 				nbIterations;		/**< Number of gradient iterations performed. **/
+		double 				time;				/**< Time (in seconds) spent on solving. **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. Builds the flat scaled structure of the relaxation. **/
+		FirstOrderSolver(const Data& data);
+		FirstOrderSolver(const Data&&) = delete;
+		FirstOrderSolver() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns the best lower bound on the LP value. **/
+		const double& getLowerBound() const { return lowerBound; }
+
+		/** Returns the cost of the fractional assignments. **/
+		const double& getPrimalValue() const { return primalValue; }
+
+		/** Returns the largest relative capacity violation of the fractional assignments. **/
+		const double& getMaxViolation() const { return maxViolation; }
+
+		/** Returns the fractional assignment of candidate c of demand i. **/
+		double getAssignment(const int i, const int c) const { return assignment[candidateStart[i] + c]; }
+
+		/** Returns the dual multiplier of the capacity row of the given link (original units). **/
+		double getMultiplier(const int link) const;
+
+		/** Returns the time (in seconds) spent on solving. **/
+		const double& getTime() const { return time; }
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Evaluates the smoothed dual function at u. Returns the smoothed value and fills the gradient, the exact Lagrangian value, the primal cost and the fractional assignments (if asked). **/
+		double evaluate(const std::vector<double> &u, const double mu, std::vector<double> &gradient, double &exact, double &primal, std::vector<double> *z) const;
+
+		/** Evaluates the demands in [first, last) at u. Partial sums are accumulated in the given arguments. **/
+		void evaluateRange(const int first, const int last, const std::vector<double> &u, const double mu, std::vector<double> &gradient, double &smooth, double &exact, double &primal, std::vector<double> *z) const;
+
+		/** Solves the linear relaxation. **/
+		void run();
+
+		/** Displays the obtained results **/
+		void printResult();
+
+		/** Outputs the obtained results **/
+		void output();
+};
+
+
+#endif
@@ -1,13 +1,21 @@
 #include "model.hpp"
+#include "callback.hpp"
 
 /****************************************************************************************/
 /*										Constructors									*/
 /****************************************************************************************/
 
-Model::Model(const IloEnv& env_, const Data& data_) : 
-                env(env_), model(env), cplex(model), data(data_), 
-                obj(env), constraints(env)
+Model::Model(const IloEnv& env_, const Data& data_, const std::vector<int>& demands_) : 
+                env(env_), model(env), cplex(model), data(data_), demands(demands_), conditioning(data_, demands_),
+                obj(env), objectiveScale(conditioning.getCostScale()), constraints(env), columns(env), values(env),
+                startCost(DBL_MAX), nbFixed(-1), fixingTime(0.0), callback(NULL), exportFile("mip.lp"), time(0.0)
 {
+    /* By default, the model handles every demand. */
+    if (demands.empty()){
+        for (int i = 0; i < data.getNbDemands(); i++){
+            demands.push_back(i);
+        }
+    }
 
     std::cout << "=> Building model ... " << std::endl;
     
@@ -15,6 +23,8 @@ Model::Model(const IloEnv& env_, const Data& data_) :
     setObjective();  
     setConstraints();  
     setCplexParameters();
+    setCoverCuts();
+    conditioning.print();
 
     std::cout << "=> Model was correctly built ! " << std::endl;                 
 }
@@ -29,10 +39,15 @@ void Model::setVariables(){
     const int NB_DEMANDS = data.getNbDemands();
 
     std::cout << "\t Setting up variables... " << std::endl;
+    IloNum start = cplex.getCplexTime();
     // setCentralUnitPlacementVariables(NB_DEMANDS, NB_NODES);
     // setDistributedUnitPlacementVariables(NB_DEMANDS, NB_NODES);
     setLinearizationVariables(NB_DEMANDS, NB_NODES);
     // setConcurrentVariables(NB_DEMANDS, NB_NODES);
+    if (data.getInput().getParetoPoints() > 0){
+        setUtilizationVariable();
+    }
+    addBuildStep("variables", start);
     std::cout << "\t All variables are set up! " << std::endl;
 }
 
@@ -80,29 +95,36 @@ void Model::setDistributedUnitPlacementVariables(const int NB_DEMANDS, const int
 
 /* Set up the linearization variables z. */
 void Model::setLinearizationVariables(const int NB_DEMANDS, const int NB_NODES){
-    /* Total placement variables. z[i][j][k] = 1 if demand i has a DU in node j and CU in node k. */
+    /* Total placement variables. z[i][c] = 1 if demand i has its DU and CU on the nodes of its c-th candidate. */
+    /* Only (DU,CU) pairs kept in the candidate table get a column: the others cannot be used. */
     std::cout << "\t >> Setting up Linearization variables. " << std::endl;
     z.resize(NB_DEMANDS);
-    for (int i = 0; i < NB_DEMANDS; i++){
-        z[i].resize(NB_NODES);
-        int sourceId = data.getDemand(i).getSource();
-        Graph::Node sourceNode = data.getGraph().nodeFromId(sourceId);
-        for (NodeIt duNode(data.getGraph()); duNode != lemon::INVALID; ++duNode){
-            int j = data.getNodeId(duNode);
-            z[i][j].resize(NB_NODES);
-            for (NodeIt cuNode(data.getGraph()); cuNode != lemon::INVALID; ++cuNode){
-                int k = data.getNodeId(cuNode);
-                std::string name = "z(" + std::to_string(i) + "," + std::to_string(j) + "," + std::to_string(k) + ")";
-                IloNumVar::Type varType = data.getInput().isRelaxation() ? ILOFLOAT : ILOBOOL;
-                double upperBound = (data.areNeighbors(sourceNode, duNode) && data.areNeighbors(duNode, cuNode)) ? 1.0 : 0.0;
-
-                z[i][j][k] = IloNumVar(env, 0.0, upperBound, varType, name.c_str());
-                model.add(z[i][j][k]);
-            }
+    columnStart.assign(demands.size() + 1, 0);
+    for (unsigned int d = 0; d < demands.size(); d++){
+        int i = demands[d];
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        z[i].resize(candidates.size());
+        columnStart[d+1] = columnStart[d] + candidates.size();
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            int j = candidates[c].getDU();
+            int k = candidates[c].getCU();
+            std::string name = "z(" + std::to_string(i) + "," + std::to_string(j) + "," + std::to_string(k) + ")";
+            IloNumVar::Type varType = data.getInput().isRelaxation() ? ILOFLOAT : ILOBOOL;
+
+            z[i][c] = IloNumVar(env, 0.0, 1.0, varType, name.c_str());
+            model.add(z[i][c]);
+            columns.add(z[i][c]);
         }
     }
 }
 
+/* Set up the peak utilization variable. */
+void Model::setUtilizationVariable(){
+    std::cout << "\t >> Setting up peak utilization variable. " << std::endl;
+    utilization = IloNumVar(env, 0.0, 1.0, ILOFLOAT, "utilization");
+    model.add(utilization);
+}
+
 void Model::setConcurrentVariables(const int NB_DEMANDS, const int NB_NODES)
 {
     /* Concurrent placement variables. c[i1][i2][j][k] = 1 if demand i1 and demand i2 have both a DU in node j and CU in node k. */
@@ -140,23 +162,14 @@ void Model::setConcurrentVariables(const int NB_DEMANDS, const int NB_NODES)
 void Model::setObjective(){
 
     std::cout << "\t Setting up objective function... " << std::endl;
+    IloNum start = cplex.getCplexTime();
 	IloExpr exp(env);
     /* Placement costs */
-    for (int i = 0; i < data.getNbDemands(); i++){
-        int sourceId = data.getDemand(i).getSource();
-        Graph::Node sourceNode = data.getGraph().nodeFromId(sourceId);
-        for(NodeIt duNode(data.getGraph()); duNode != lemon::INVALID; ++duNode) {
-            if (data.areNeighbors(sourceNode, duNode)){
-                int j = data.getNodeId(duNode);
-                double costDU = data.getDistributedUnitPlacementCost(data.getNode(j));
-                for(NodeIt cuNode(data.getGraph()); cuNode != lemon::INVALID; ++cuNode) {
-                    if (data.areNeighbors(duNode, cuNode)){
-                        int k = data.getNodeId(cuNode);
-                        double costCU = data.getCentralUnitPlacementCost(data.getNode(k));
-                        exp += ( (costCU + costDU)*z[i][j][k] ); 
-                    }
-                }
-            }
+    for (unsigned int d = 0; d < demands.size(); d++){
+        int i = demands[d];
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            exp += ( conditioning.cost(candidates[c].getCost())*z[i][c] ); 
         }
     }
 
@@ -173,9 +186,30 @@ void Model::setObjective(){
 	obj.setSense(IloObjective::Minimize);
     model.add(obj);
 
+	exp.clear();
+    exp.end();
+    addBuildStep("objective", start);
+
     std::cout << "\t Objective function has been set up! " << std::endl;
+}
 
-	exp.clear();
+/* Minimizes either the peak utilization or the placement cost. */
+void Model::setUtilizationObjective(const bool minimizeUtilization){
+    objectiveScale = minimizeUtilization ? 1.0 : conditioning.getCostScale();
+    IloExpr exp(env);
+    if (minimizeUtilization){
+        exp += utilization;
+    }
+    else{
+        for (unsigned int d = 0; d < demands.size(); d++){
+            int i = demands[d];
+            const std::vector<Candidate>& candidates = data.getCandidates(i);
+            for (unsigned int c = 0; c < candidates.size(); c++){
+                exp += ( conditioning.cost(candidates[c].getCost())*z[i][c] );
+            }
+        }
+    }
+    obj.setExpr(exp);
     exp.end();
 }
 
@@ -195,12 +229,26 @@ void Model::setConstraints(){
     // setLinearityConstraints1();
     // setLinearityConstraints2();
     // setLinearityConstraints3();
+    IloNum start = cplex.getCplexTime();
     setPlacementConstraints();
+    addBuildStep("placementConstraints", start);
+
+    start = cplex.getCplexTime();
     setLinkCapacityConstraints();
-    setConcurrentConstraints();
+    addBuildStep("linkCapacityConstraints", start);
+
+    if (data.getInput().isSymmetryBreaking()){
+        start = cplex.getCplexTime();
+        setSymmetryBreakingConstraints();
+        addBuildStep("symmetryBreakingConstraints", start);
+    }
+
+    // setConcurrentConstraints();
     setDelayConstraints();
 
+    start = cplex.getCplexTime();
     model.add(constraints);
+    addBuildStep("constraintExtraction", start);
     std::cout << "\t The constraint matrix has been set up! " << std::endl;
 
 }
@@ -274,20 +322,11 @@ void Model::setConstraints(){
 void Model::setPlacementConstraints(){
     std::cout << "\t > Setting up central unit assignment constraints " << std::endl;
 
-    for (int i = 0; i < data.getNbDemands(); i++){
-        int ruNodeId = data.getDemand(i).getSource();
-        Graph::Node ruNode = data.getGraph().nodeFromId(ruNodeId);
+    for (unsigned int d = 0; d < demands.size(); d++){
+        int i = demands[d];
         IloExpr exp(env);
-        for(NodeIt duNode(data.getGraph()); duNode != lemon::INVALID; ++duNode) {
-            if (data.areNeighbors(ruNode, duNode)){
-                int j = data.getNodeId(duNode);
-                for(NodeIt cuNode(data.getGraph()); cuNode != lemon::INVALID; ++cuNode) {
-                    if (data.areNeighbors(duNode, cuNode)){
-                        int k = data.getNodeId(cuNode);
-                        exp += z[i][j][k]; 
-                    }
-                }
-            }
+        for (unsigned int c = 0; c < z[i].size(); c++){
+            exp += z[i][c]; 
         }
         std::string name = "Placement(" + std::to_string(i) + ")";
         constraints.add(IloRange(env, 1, exp, 1, name.c_str()));
@@ -300,56 +339,141 @@ void Model::setPlacementConstraints(){
 void Model::setLinkCapacityConstraints(){
     std::cout << "\t > Setting up Link Capacity Constraints " << std::endl;
 
+    /* Under throughput scenarios, capacity rows are generated per scenario by the robust solver. */
+    if (data.getNbScenarios() > 0){
+        return;
+    }
+
+    /* Gather the candidates consuming the capacity of each link. */
+    const int NB_LINKS = data.getNbLinks();
+    std::vector<std::vector<std::pair<int, int> > > users(NB_LINKS);
+    for (unsigned int d = 0; d < demands.size(); d++){
+        int i = demands[d];
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            for (unsigned int l = 0; l < candidates[c].getListOfLinks().size(); l++){
+                users[candidates[c].getListOfLinks()[l]].push_back(std::make_pair(i, (int)c));
+            }
+        }
+    }
+
+    /* In the Pareto sweep, every used link bounds the peak utilization, even the ones that never reach their capacity. */
+    bool pareto = (data.getInput().getParetoPoints() > 0);
     for (ArcIt l(data.getGraph()); l != lemon::INVALID; ++l){
+        int linkId = data.getArcId(l);
+        /* Rows that presolve proved redundant, or that no candidate uses, are not written. */
+        if ((!pareto && !data.isCapacityActive(linkId)) || users[linkId].empty()){
+            continue;
+        }
         IloExpr exp(env);
-
-        int j = data.getGraph().id(data.getGraph().source(l));
-        int k = data.getGraph().id(data.getGraph().target(l));
-        double mu = data.getLink(data.getGraph().id(l)).getCapacity();
-        // cout << j << " " << k << " " << mu;
-        for (int i = 0; i < data.getNbDemands(); i++){
-            double lambda = data.getDemand(i).getThroughput();
-            cout << " " << lambda << " ";
-            exp += lambda * z[i][j][k];
+        double mu = conditioning.throughput(data.getLink(linkId).getCapacity());
+        for (unsigned int u = 0; u < users[linkId].size(); u++){
+            int i = users[linkId][u].first;
+            double lambda = conditioning.throughput(data.getDemand(i).getThroughput());
+            exp += lambda * z[i][users[linkId][u].second];
         }
-        // cout << endl;
 
         std::string name = "Capacity of link(" + std::to_string(data.getGraph().id(l)) + ")";
-        constraints.add(IloRange(env, 0, exp, mu, name.c_str()));
+        if (pareto){
+            exp -= mu * utilization;
+            constraints.add(IloRange(env, -IloInfinity, exp, 0, name.c_str()));
+        }
+        else{
+            constraints.add(IloRange(env, 0, exp, mu, name.c_str()));
+        }
+        capacityRowLinks.push_back(linkId);
         exp.clear();
         exp.end();
     }
 }
 
+/* Set up the symmetry-breaking constraints: inside each orbit of interchangeable nodes, the throughput hosted by the nodes is non-increasing. */
+void Model::setSymmetryBreakingConstraints(){
+    std::cout << "\t > Setting up Symmetry Breaking Constraints " << std::endl;
+
+    Symmetry symmetry(data);
+    symmetry.run();
+    symmetry.print();
+    const std::vector<std::vector<int> >& orbits = symmetry.getOrbits();
+    if (orbits.empty()){
+        return;
+    }
+
+    /* hosted[j] gathers the throughput of the demands placing a DU or a CU on node j. */
+    std::vector<IloExpr> hosted;
+    std::vector<int> position(data.getNbNodes(), -1);
+    for (unsigned int o = 0; o < orbits.size(); o++){
+        for (unsigned int n = 0; n < orbits[o].size(); n++){
+            position[orbits[o][n]] = hosted.size();
+            hosted.push_back(IloExpr(env));
+        }
+    }
+    for (unsigned int d = 0; d < demands.size(); d++){
+        int i = demands[d];
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        double lambda = conditioning.throughput(data.getDemand(i).getThroughput());
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            int du = candidates[c].getDU();
+            int cu = candidates[c].getCU();
+            if (position[du] >= 0){
+                hosted[position[du]] += lambda * z[i][c];
+            }
+            if (cu != du && position[cu] >= 0){
+                hosted[position[cu]] += lambda * z[i][c];
+            }
+        }
+    }
+
+    /* Any placement can be permuted inside an orbit so that hosted throughputs are sorted. */
+    for (unsigned int o = 0; o < orbits.size(); o++){
+        for (unsigned int n = 0; n + 1 < orbits[o].size(); n++){
+            IloExpr exp(env);
+            exp += hosted[position[orbits[o][n]]] - hosted[position[orbits[o][n+1]]];
+            std::string name = "Symmetry(" + std::to_string(orbits[o][n]) + "," + std::to_string(orbits[o][n+1]) + ")";
+            constraints.add(IloRange(env, 0, exp, IloInfinity, name.c_str()));
+            symmetryRowNodes.push_back(std::make_pair(orbits[o][n], orbits[o][n+1]));
+            exp.clear();
+            exp.end();
+        }
+    }
+    for (unsigned int h = 0; h < hosted.size(); h++){
+        hosted[h].end();
+    }
+}
+
 void Model::setConcurrentConstraints()
 {
-    for (int i1 = 0; i1 < data.getNbDemands(); i1++){
+    for (unsigned int d1 = 0; d1 < demands.size(); d1++){
+        int i1 = demands[d1];
         Graph::Node ruNode1 = data.getGraph().nodeFromId(data.getDemand(i1).getSource());
-        for (int i2 = 0; i2 < data.getNbDemands(); i2++){
+        for (unsigned int d2 = 0; d2 < demands.size(); d2++){
+            int i2 = demands[d2];
             Graph::Node ruNode2 = data.getGraph().nodeFromId(data.getDemand(i2).getSource());
             for (NodeIt duNode(data.getGraph()); duNode != lemon::INVALID; ++duNode){
                 if (data.areNeighbors(ruNode1, duNode) && data.areNeighbors(ruNode2, duNode)){
                     int j = data.getNodeId(duNode);
                     for (NodeIt cuNode(data.getGraph()); cuNode != lemon::INVALID; ++cuNode){
-                        if (data.areNeighbors(duNode, cuNode)){
-                            int k = data.getNodeId(cuNode);
+                        int k = data.getNodeId(cuNode);
+                        int c1 = data.getCandidateIndex(i1, j, k);
+                        int c2 = data.getCandidateIndex(i2, j, k);
+                        if (c1 >= 0 && c2 >= 0){
 
                             IloExpr exp1(env);
-                            exp1 += concurrent[i1][i2][j][k] - z[i1][j][k];
+                            exp1 += concurrent[i1][i2][j][k] - z[i1][c1];
                             std::string name1 = "ConcurrentLinearization1(" + std::to_string(i1) + "," + std::to_string(i2) + "," + std::to_string(j) + "," + std::to_string(k) + ")";
                             constraints.add(IloRange(env, -IloInfinity, exp1, 0, name1.c_str()));
                             exp1.clear();
                             exp1.end();
 
                             IloExpr exp2(env);
-                            exp2 += concurrent[i1][i2][j][k] - z[i2][j][k];
+                            exp2 += concurrent[i1][i2][j][k] - z[i2][c2];
                             std::string name2 = "ConcurrentLinearization2(" + std::to_string(i1) + "," + std::to_string(i2) + "," + std::to_string(j) + "," + std::to_string(k) + ")";
                             constraints.add(IloRange(env, -IloInfinity, exp2, 0, name2.c_str()));
                             exp2.clear();
                             exp2.end();
 
                             IloExpr exp3(env);
-                            exp3 += z[i1][j][k] + z[i2][j][k] - concurrent[i1][i2][j][k];
+                            exp3 += z[i1][c1] + z[i2][c2] - concurrent[i1][i2][j][k];
                             std::string name3 = "ConcurrentLinearization3(" + std::to_string(i1) + "," + std::to_string(i2) + "," + std::to_string(j) + "," + std::to_string(k) + ")";
                             constraints.add(IloRange(env, -IloInfinity, exp3, 1, name3.c_str()));
                             exp3.clear();
@@ -477,31 +601,453 @@ void Model::setDelayConstraints()
 // }
 
 
+/* Returns the chosen candidate of each demand handled by the model (-1 otherwise). */
+std::vector<int> Model::getPlacement() const{
+    std::vector<int> placement(data.getNbDemands(), -1);
+    if (!isSolutionAvailable()){
+        return placement;
+    }
+    for (unsigned int d = 0; d < demands.size(); d++){
+        for (int col = columnStart[d]; col < columnStart[d+1]; col++){
+            if (values[col] > 1 - EPS){
+                placement[demands[d]] = col - columnStart[d];
+            }
+        }
+    }
+    return placement;
+}
+
+/* Returns the placement cost of the solution. */
+double Model::getPlacementCost() const{
+    double cost = 0.0;
+    std::vector<int> placement = getPlacement();
+    for (unsigned int d = 0; d < demands.size(); d++){
+        int i = demands[d];
+        if (placement[i] >= 0){
+            cost += data.getCandidates(i)[placement[i]].getCost();
+        }
+    }
+    return cost;
+}
+
+/* Returns the largest load over capacity among the links used by the solution. */
+double Model::getPeakUtilization() const{
+    return getPeakUtilization(getPlacement());
+}
+
+/* Returns the largest load over capacity among the links used by the given placement. */
+double Model::getPeakUtilization(const std::vector<int>& placement) const{
+    std::vector<double> load(data.getNbLinks(), 0.0);
+    double peak = 0.0;
+    for (unsigned int d = 0; d < demands.size(); d++){
+        int i = demands[d];
+        if (placement[i] < 0){
+            continue;
+        }
+        const std::vector<int>& links = data.getCandidates(i)[placement[i]].getListOfLinks();
+        for (unsigned int l = 0; l < links.size(); l++){
+            load[links[l]] += data.getDemand(i).getThroughput();
+            peak = std::max(peak, load[links[l]] / data.getLink(links[l]).getCapacity());
+        }
+    }
+    return peak;
+}
+
+/* Limits the number of threads used by Cplex. */
+void Model::setThreads(const int nbThreads){
+    cplex.setParam(IloCplex::Param::Threads, nbThreads);
+}
+
+/* Limits the time of the next solves. */
+void Model::setTimeLimit(const double seconds){
+    cplex.setParam(IloCplex::Param::TimeLimit, seconds);
+}
+
+/* Turns off the Cplex log. */
+void Model::setQuiet(){
+    cplex.setOut(env.getNullStream());
+    cplex.setWarning(env.getNullStream());
+}
+
+/* Installs the given placement as a MIP start. */
+void Model::setMipStart(const std::vector<int>& placement){
+    starts.push_back(placement);
+    startCost = std::min(startCost, getStartCost(placement));
+    addMipStart(placement);
+}
+
+/* Adds the given placement to the MIP starts of Cplex. */
+void Model::addMipStart(const std::vector<int>& placement){
+    IloNumVarArray vars(env);
+    IloNumArray vals(env);
+    bool complete = true;
+    for (unsigned int d = 0; d < demands.size(); d++){
+        int i = demands[d];
+        if (placement[i] < 0){
+            complete = false;
+            continue;
+        }
+        for (unsigned int c = 0; c < z[i].size(); c++){
+            vars.add(z[i][c]);
+            vals.add((int)c == placement[i] ? 1.0 : 0.0);
+        }
+    }
+    /* A partial start is completed by a sub-MIP; a complete one is only repaired if it violates some symmetry row. */
+    if (vars.getSize() > 0){
+        cplex.addMIPStart(vars, vals, complete ? IloCplex::MIPStartRepair : IloCplex::MIPStartSolveMIP, "warmstart");
+    }
+    vars.end();
+    vals.end();
+}
+
+/* Solves the linear relaxation of the model in place. */
+bool Model::solveRelaxation(std::vector<std::vector<double> >& fractional, double& value, std::vector<std::vector<double> >* reducedCosts)
+{
+    /* The conversion relaxes the integrality of the columns without rebuilding the model. */
+    IloConversion relaxation;
+    if (!data.getInput().isRelaxation()){
+        relaxation = IloConversion(env, columns, ILOFLOAT);
+        model.add(relaxation);
+    }
+    IloNum start = cplex.getCplexTime();
+    cplex.solve();
+    time = cplex.getCplexTime() - start;
+
+    bool solved = (cplex.getStatus() == IloAlgorithm::Optimal);
+    fractional.assign(data.getNbDemands(), std::vector<double>());
+    value = 0.0;
+    if (solved){
+        IloNumArray lp(env);
+        cplex.getValues(lp, columns);
+        for (unsigned int d = 0; d < demands.size(); d++){
+            for (int col = columnStart[d]; col < columnStart[d+1]; col++){
+                fractional[demands[d]].push_back(lp[col]);
+            }
+        }
+        lp.end();
+        value = getObjValue();
+        if (reducedCosts != NULL){
+            IloNumArray dj(env);
+            cplex.getReducedCosts(dj, columns);
+            reducedCosts->assign(data.getNbDemands(), std::vector<double>());
+            for (unsigned int d = 0; d < demands.size(); d++){
+                for (int col = columnStart[d]; col < columnStart[d+1]; col++){
+                    (*reducedCosts)[demands[d]].push_back(dj[col] * objectiveScale);
+                }
+            }
+            dj.end();
+        }
+    }
+    if (!data.getInput().isRelaxation()){
+        model.remove(relaxation);
+        relaxation.end();
+        /* Cplex may drop the MIP starts while the conversion makes the problem an LP: they are installed again. */
+        if (!starts.empty()){
+            if (cplex.getNMIPStarts() > 0){
+                cplex.deleteMIPStarts(0, cplex.getNMIPStarts());
+            }
+            for (unsigned int s = 0; s < starts.size(); s++){
+                addMipStart(starts[s]);
+            }
+        }
+    }
+    return solved;
+}
+
+/* Rounds the relaxation into a placement. */
+std::vector<int> Model::roundRelaxation(const std::vector<std::vector<double> >& fractional) const
+{
+    std::vector<double> confidence(data.getNbDemands(), 0.0);
+    std::vector<int> order(demands);
+    for (unsigned int d = 0; d < demands.size(); d++){
+        int i = demands[d];
+        for (unsigned int c = 0; c < fractional[i].size(); c++){
+            confidence[i] = std::max(confidence[i], fractional[i][c]);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&](const int a, const int b){ return confidence[a] > confidence[b]; });
+
+    std::vector<double> residual(data.getNbLinks());
+    for (int l = 0; l < data.getNbLinks(); l++){
+        residual[l] = (1.0 + FIXING_TOLERANCE) * data.getLink(l).getCapacity();
+    }
+    std::vector<int> placement(data.getNbDemands(), -1);
+    for (unsigned int d = 0; d < order.size(); d++){
+        int i = order[d];
+        double throughput = data.getDemand(i).getThroughput();
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        int chosen = -1;
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            if (chosen >= 0 && fractional[i][c] <= fractional[i][chosen]){
+                continue;
+            }
+            bool fits = true;
+            const std::vector<int>& links = candidates[c].getListOfLinks();
+            for (unsigned int l = 0; l < links.size() && fits; l++){
+                fits = (!data.isCapacityActive(links[l]) || throughput <= residual[links[l]]);
+            }
+            if (fits){
+                chosen = c;
+            }
+        }
+        if (chosen < 0){
+            return std::vector<int>();
+        }
+        const std::vector<int>& links = candidates[chosen].getListOfLinks();
+        for (unsigned int l = 0; l < links.size(); l++){
+            residual[links[l]] -= throughput;
+        }
+        placement[i] = chosen;
+    }
+    return placement;
+}
+
+/* Returns the cost of the placement if it is complete and fits the link capacities. */
+double Model::getStartCost(const std::vector<int>& placement) const
+{
+    std::vector<double> load(data.getNbLinks(), 0.0);
+    double cost = 0.0;
+    for (unsigned int d = 0; d < demands.size(); d++){
+        int i = demands[d];
+        if (placement.empty() || placement[i] < 0){
+            return DBL_MAX;
+        }
+        const Candidate& candidate = data.getCandidates(i)[placement[i]];
+        for (unsigned int l = 0; l < candidate.getListOfLinks().size(); l++){
+            int link = candidate.getListOfLinks()[l];
+            load[link] += data.getDemand(i).getThroughput();
+            if (data.isCapacityActive(link) && load[link] > (1.0 + FIXING_TOLERANCE) * data.getLink(link).getCapacity()){
+                return DBL_MAX;
+            }
+        }
+        cost += candidate.getCost();
+    }
+    return cost;
+}
+
+/* Solves the root LP in place and fixes to 0 the z columns priced out by the gap. */
+void Model::fixByReducedCosts()
+{
+    std::cout << "=> Reduced-cost fixing ..." << std::endl;
+    IloNum start = cplex.getCplexTime();
+    std::vector<std::vector<double> > fractional, reducedCosts;
+    double lpValue = 0.0;
+    nbFixed = 0;
+    if (!solveRelaxation(fractional, lpValue, &reducedCosts)){
+        std::cout << "\t The root LP was not solved to optimality: no column is fixed." << std::endl;
+        fixingTime = cplex.getCplexTime() - start;
+        return;
+    }
+
+    /* Without a MIP start, the rounded LP gives the upper bound and becomes the start. */
+    if (startCost >= DBL_MAX){
+        std::vector<int> rounded = roundRelaxation(fractional);
+        if (!rounded.empty()){
+            setMipStart(rounded);
+        }
+    }
+    if (startCost >= DBL_MAX){
+        std::cout << "\t No placement is known: no column is fixed." << std::endl;
+        fixingTime = cplex.getCplexTime() - start;
+        return;
+    }
+
+    /* A column with z = 1 costs at least the LP value plus its reduced cost: above the best known cost, it cannot improve on it. */
+    /* With a pool, the placements within the pool gap of the best known one are kept as well. */
+    double gap = startCost + data.getInput().getPoolGap() * (data.getInput().getPoolSize() > 0 ? std::fabs(startCost) : 0.0) - lpValue;
+    double tolerance = FIXING_TOLERANCE * std::max(1.0, std::fabs(startCost));
+    int nbColumns = 0;
+    for (unsigned int d = 0; d < demands.size(); d++){
+        int i = demands[d];
+        for (unsigned int c = 0; c < z[i].size(); c++){
+            nbColumns++;
+            if (reducedCosts[i][c] > gap + tolerance){
+                z[i][c].setUB(0.0);
+                nbFixed++;
+            }
+        }
+    }
+    fixingTime = cplex.getCplexTime() - start;
+    std::cout << "\t Root LP " << lpValue << ", best known placement " << startCost << " (gap " << gap << ")." << std::endl;
+    std::cout << "\t " << nbFixed << " of " << nbColumns << " z columns fixed to 0." << std::endl;
+    std::cout << "=> Reduced-cost fixing done in " << fixingTime << " seconds." << std::endl;
+}
+
+/* Records the time spent on a model building step. */
+void Model::addBuildStep(const std::string& name, const IloNum start){
+    buildStepNames.push_back(name);
+    buildStepTimes.push_back(cplex.getCplexTime() - start);
+}
+
 void Model::run()
 {
-    cplex.exportModel("mip.lp");
+    /* Two phases: the root LP prunes the columns, once, then the MIP is solved on what is left within the remaining time. */
+    bool fixing = (data.getInput().isReducedCostFixing() && !data.getInput().isRelaxation() && nbFixed < 0
+                   && data.getNbScenarios() == 0 && data.getInput().getParetoPoints() == 0);
+    const IloNum timeLimit = cplex.getParam(IloCplex::Param::TimeLimit);
+    if (fixing){
+        fixByReducedCosts();
+        cplex.setParam(IloCplex::Param::TimeLimit, std::max(1.0, timeLimit - fixingTime));
+    }
+    if (!exportFile.empty()){
+        cplex.exportModel(exportFile.c_str());
+    }
     time = cplex.getCplexTime();
 	cplex.solve();
 
 	/* Get final execution time */
-	time = cplex.getCplexTime() - time;
+	time = cplex.getCplexTime() - time + (fixing ? fixingTime : 0.0);
+
+    /* The pool goes on from the tree of the solve, within the time left, instead of solving again for each placement. */
+    /* Without time left, the pool holds the placements found by the solve only. */
+    bool found = (cplex.getStatus() == IloAlgorithm::Optimal || cplex.getStatus() == IloAlgorithm::Feasible);
+    if (found && data.getInput().getPoolSize() > 0){
+        IloNum start = cplex.getCplexTime();
+        double remaining = timeLimit - time;
+        if (remaining > 0.0){
+            std::cout << "=> Populating the solution pool ..." << std::endl;
+            cplex.setParam(IloCplex::Param::TimeLimit, remaining);
+            cplex.populate();
+        }
+        else{
+            std::cout << "=> No time left to populate the solution pool." << std::endl;
+        }
+        readPool();
+        time += cplex.getCplexTime() - start;
+    }
+
+    /* All the column values are read at once: O(non-zeros) instead of one call per variable. */
+    values.clear();
+    if (cplex.getStatus() == IloAlgorithm::Optimal || cplex.getStatus() == IloAlgorithm::Feasible){
+        cplex.getValues(values, columns);
+    }
+    /* Under scenarios or in the Pareto sweep, some rows (or bounds) of the model are not in the constraint set. */
+    bool infeasible = (cplex.getStatus() == IloAlgorithm::Infeasible || cplex.getStatus() == IloAlgorithm::InfeasibleOrUnbounded);
+    if (infeasible && data.getNbScenarios() == 0 && data.getInput().getParetoPoints() == 0){
+        refineConflict();
+    }
+}
+
+/* Reads the placements of the solution pool and keeps the cheapest distinct ones within the pool gap. */
+void Model::readPool()
+{
+    pool.clear();
+    poolCosts.clear();
+    std::vector<std::pair<double, std::vector<int> > > found;
+    IloNumArray solution(env);
+    for (IloInt s = 0; s < cplex.getSolnPoolNsolns(); s++){
+        cplex.getValues(solution, columns, s);
+        std::vector<int> placement(data.getNbDemands(), -1);
+        for (unsigned int d = 0; d < demands.size(); d++){
+            for (int col = columnStart[d]; col < columnStart[d+1]; col++){
+                if (solution[col] > 1 - EPS){
+                    placement[demands[d]] = col - columnStart[d];
+                }
+            }
+        }
+        found.push_back(std::make_pair(cplex.getObjValue(s) * objectiveScale, placement));
+    }
+    solution.end();
+
+    /* Pool members differ in some column, so they are distinct placements; the check only guards against rounding. */
+    std::stable_sort(found.begin(), found.end(), [](const std::pair<double, std::vector<int> >& a, const std::pair<double, std::vector<int> >& b){ return a.first < b.first; });
+    for (unsigned int s = 0; s < found.size() && (int)pool.size() < data.getInput().getPoolSize(); s++){
+        if (found[s].first > found[0].first + data.getInput().getPoolGap() * std::fabs(found[0].first) + FIXING_TOLERANCE * std::max(1.0, std::fabs(found[0].first))){
+            break;
+        }
+        if (std::find(pool.begin(), pool.end(), found[s].second) == pool.end()){
+            pool.push_back(found[s].second);
+            poolCosts.push_back(found[s].first);
+        }
+    }
+    std::cout << "\t " << pool.size() << " distinct placement(s) within " << data.getInput().getPoolGap()*100 << "% of the best, out of " << found.size() << " in the pool." << std::endl;
+}
+
+/* Runs the conflict refiner on the placement, capacity and symmetry rows and explains the conflict. */
+void Model::refineConflict()
+{
+    std::cout << "=> Refining conflict ..." << std::endl;
+    IloNum start = cplex.getCplexTime();
+    conflict.clear();
+    IloConstraintArray rows(env);
+    IloNumArray preferences(env);
+    for (IloInt r = 0; r < constraints.getSize(); r++){
+        rows.add(constraints[r]);
+        preferences.add(1.0);
+    }
+    if (!cplex.refineConflict(rows, preferences)){
+        std::cout << "\t No conflict was found among the placement, capacity and symmetry rows." << std::endl;
+        rows.end();
+        preferences.end();
+        return;
+    }
+    IloCplex::ConflictStatusArray status = cplex.getConflict(rows);
+
+    /* Rows are explained by family; the nodes, links and demands involved are gathered on the way. */
+    const int NB_PLACEMENT_ROWS = demands.size();
+    const int NB_CAPACITY_ROWS = capacityRowLinks.size();
+    std::vector<bool> nodes(data.getNbNodes(), false);
+    int nbDemands = 0, nbLinks = 0;
+    for (IloInt r = 0; r < rows.getSize(); r++){
+        if (status[r] == IloCplex::ConflictExcluded){
+            continue;
+        }
+        std::string member = (status[r] == IloCplex::ConflictMember) ? "" : " (possible member)";
+        if (r < NB_PLACEMENT_ROWS){
+            int i = demands[r];
+            int ru = data.getDemand(i).getSource();
+            nodes[ru] = true;
+            nbDemands++;
+            conflict.push_back("Placement: demand '" + data.getDemand(i).getName() + "' (throughput " + formatNumber(data.getDemand(i).getThroughput())
+                               + ") is placed on one of its " + std::to_string(data.getCandidates(i).size()) + " candidate(s) from RU node '" + data.getNode(ru).getName() + "'" + member);
+        }
+        else if (r < NB_PLACEMENT_ROWS + NB_CAPACITY_ROWS){
+            Link link = data.getLink(capacityRowLinks[r - NB_PLACEMENT_ROWS]);
+            nodes[link.getSource()] = true;
+            nodes[link.getTarget()] = true;
+            nbLinks++;
+            conflict.push_back("Capacity: link '" + link.getName() + "' ('" + data.getNode(link.getSource()).getName() + "' -> '" + data.getNode(link.getTarget()).getName()
+                               + "') carries at most " + formatNumber(link.getCapacity()) + member);
+        }
+        else {
+            const std::pair<int, int>& pair = symmetryRowNodes[r - NB_PLACEMENT_ROWS - NB_CAPACITY_ROWS];
+            nodes[pair.first] = true;
+            nodes[pair.second] = true;
+            conflict.push_back("Symmetry: node '" + data.getNode(pair.first).getName() + "' hosts at least the throughput of node '" + data.getNode(pair.second).getName() + "'" + member);
+        }
+    }
+    std::string involved = "";
+    for (int v = 0; v < data.getNbNodes(); v++){
+        if (nodes[v]){
+            involved += (involved.empty() ? "'" : ", '") + data.getNode(v).getName() + "'";
+        }
+    }
+    status.end();
+    rows.end();
+    preferences.end();
+
+    std::cout << "\t Minimal conflict (" << conflict.size() << " rows, found in " << cplex.getCplexTime() - start << " seconds):" << std::endl;
+    for (unsigned int c = 0; c < conflict.size(); c++){
+        std::cout << "\t\t " << conflict[c] << std::endl;
+    }
+    std::cout << "\t " << nbDemands << " demand(s) and " << nbLinks << " link(s) involved, on nodes " << involved << "." << std::endl;
 }
 
 void Model::printResult(){
     
-    const int NB_DEMANDS = data.getNbDemands();
     std::cout << "=> Printing solution ..." << std::endl;
-    for (int ii = 0; ii < NB_DEMANDS; ii++) {
-        int i = data.getDemand(ii).getSource();
+    if (!isSolutionAvailable()){
+        std::cout << "No solution available. Status: " << cplex.getStatus() << std::endl;
+        return;
+    }
+    for (unsigned int d = 0; d < demands.size(); d++) {
+        int i = demands[d];
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
         std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
-        std::cout << "Placement for RU i = " << i+1 << " is : ";
-        for (NodeIt n(data.getGraph()); n != lemon::INVALID; ++n){
-            for (NodeIt nn(data.getGraph()); nn != lemon::INVALID; ++nn){
-                int j = data.getNodeId(n);
-                int k = data.getNodeId(nn);
-                if (cplex.getValue(z[i][j][k]) > 1 - EPS){
-                    std::cout << "(" << j << "," << k << ")" << ", ";
-                }
+        std::cout << "Placement for demand " << data.getDemand(i).getName() << " is : ";
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            if (values[columnStart[d] + c] > 1 - EPS){
+                std::cout << "(" << data.getNode(candidates[c].getDU()).getName() << "," << data.getNode(candidates[c].getCU()).getName() << ")" << ", ";
             }
         }
         // std::cout << std::endl << "and (DU,CU) installed at nodes : ";
@@ -521,11 +1067,22 @@ void Model::printResult(){
     }
     std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
 
-    std::cout << "Objective value: " << cplex.getValue(obj) << std::endl;
+    std::cout << "Objective value: " << getObjValue() << std::endl;
     std::cout << "Nodes evaluated: " << cplex.getNnodes() << std::endl;
-    //std::cout << "User cuts added: " << callback->getNbUserCuts() << std::endl;
-    //std::cout << "Lazy constraints added: " << callback->getNbLazyConstraints() << std::endl;
-    //std::cout << "Time on cuts: " << callback->getTime() << std::endl;
+    if (callback != NULL){
+        std::cout << "User cuts added: " << callback->getNbUserCuts() << " (" << callback->getNbRootCuts() << " at the root)" << std::endl;
+        //std::cout << "Lazy constraints added: " << callback->getNbLazyConstraints() << std::endl;
+        std::cout << "Time on cuts: " << callback->getTime() << std::endl;
+        if (callback->isRootSeen()){
+            std::cout << "Root bound: " << callback->getRootBoundBefore() << " before cover cuts, " << callback->getRootBoundAfter() << " after" << std::endl;
+        }
+    }
+    for (unsigned int r = 0; r < pool.size(); r++){
+        std::cout << "Pool placement " << r + 1 << ": cost " << poolCosts[r] << ", peak utilization " << getPeakUtilization(pool[r]) << std::endl;
+    }
+    if (nbFixed >= 0){
+        std::cout << "Columns fixed by reduced costs: " << nbFixed << " (" << fixingTime << " seconds)" << std::endl;
+    }
     std::cout << "Total time: " << time << std::endl << std::endl;
     //testRelaxationAvail();
 }
@@ -533,8 +1090,25 @@ void Model::printResult(){
 /** Set up the Cplex parameters. **/
 void Model::setCplexParameters(){
 
+    /** Tuned settings, if any: the limits below take precedence over the ones in the file **/
+    if (!data.getInput().getCplexParamFile().empty()){
+        cplex.readParam(data.getInput().getCplexParamFile().c_str());
+    }
+
     /** Time limit definition **/
     cplex.setParam(IloCplex::Param::TimeLimit, data.getInput().getTimeLimit());    // Execution time limited
+    if (data.getInput().getNbThreads() > 0){
+        cplex.setParam(IloCplex::Param::Threads, data.getInput().getNbThreads());  // Threads limited
+    }
+
+    /** Solution pool: the poolSize cheapest placements within the pool gap, the most expensive being replaced first **/
+    if (data.getInput().getPoolSize() > 0 && !data.getInput().isRelaxation()){
+        cplex.setParam(IloCplex::Param::MIP::Pool::Capacity, data.getInput().getPoolSize());
+        cplex.setParam(IloCplex::Param::MIP::Pool::Replace, 1);
+        cplex.setParam(IloCplex::Param::MIP::Pool::RelGap, data.getInput().getPoolGap());
+        cplex.setParam(IloCplex::Param::MIP::Pool::Intensity, POOL_INTENSITY);
+        cplex.setParam(IloCplex::Param::MIP::Limits::Populate, POOL_POPULATE_FACTOR * data.getInput().getPoolSize());
+    }
 	
     // cplex.setParam(IloCplex::Param::Simplex::Tolerances::Feasibility, 1e-9);
     // cplex.setParam(IloCplex::Param::Simplex::Tolerances::Optimality, 1e-9);
@@ -549,6 +1123,24 @@ void Model::setCplexParameters(){
     // //cplex.setParam(IloCplex::Param::Threads, 1); // Treads limited
 }
 
+/* Set up the callback separating lifted cover cuts on the link capacity rows. */
+void Model::setCoverCuts(){
+    /* Cuts need integral columns and the plain capacity rows: not in the relaxation, the Pareto sweep or under scenarios. */
+    if (!data.getInput().isCoverCuts() || data.getInput().isRelaxation() || data.getInput().getParetoPoints() > 0 || data.getNbScenarios() > 0){
+        return;
+    }
+    IloNum start = cplex.getCplexTime();
+    callback = new CoverCutCallback(env, data, demands, z);
+    if (callback->getNbKnapsacks() == 0){
+        delete callback;
+        callback = NULL;
+    }
+    else{
+        cplex.use(callback, IloCplex::Callback::Context::Id::Relaxation);
+    }
+    addBuildStep("coverCuts", start);
+}
+
 void Model::output(){
     std::string output_file = data.getInput().getOutputFile();
     if (output_file.empty()){
@@ -567,16 +1159,24 @@ void Model::output(){
     std::string node_name = getInBetweenString(data.getInput().getNodeFile(), "/", ".");
     std::string instance_name = node_name + "_" + demand_name;
 
+    /* Without a solution there is no objective value to report, only the status. */
+    if (!isSolutionAvailable()){
+        fileReport << instance_name << ";" << time << ";" << cplex.getStatus() << ";" << std::endl;
+        fileReport.close();
+        return;
+    }
     fileReport << instance_name << ";"
     		   << time << ";"
-    		   << cplex.getObjValue() << ";"
-    		   << cplex.getBestObjValue() << ";"
+    		   << getObjValue() << ";"
+    		   << getBestObjValue() << ";"
     		   << cplex.getMIPRelativeGap()*100 << ";"
     		   << cplex.getNnodes() << ";"
     		   << cplex.getNnodesLeft()*0.001 << ";" 
                //<< callback->getNbLazyConstraints() << ";" 
-    		   //<< callback->getNbUserCuts() << ";" 
-    		   //<< callback->getTime() << ";" 
+    		   << (callback != NULL ? callback->getNbUserCuts() : 0) << ";" 
+    		   << (callback != NULL ? callback->getTime() : 0.0) << ";" 
+    		   << (callback != NULL ? callback->getRootBoundBefore() : 0.0) << ";" 
+    		   << (callback != NULL ? callback->getRootBoundAfter() : 0.0) << ";" 
                << std::endl;
     		   
     // Finalization ***
@@ -584,8 +1184,38 @@ void Model::output(){
 
 }
 
+/* Writes the cost, gap and peak utilization of each placement of the pool. */
+void Model::outputPool() const
+{
+    std::string placement_file = data.getInput().getPlacementFile();
+    if (placement_file.empty() || pool.empty()){
+        return;
+    }
+    std::string pool_file = insertSuffix(placement_file, "_pool");
+    std::ofstream fileReport(pool_file, std::ios_base::trunc);
+    if(!fileReport)
+    {
+        std::cerr << "ERROR: Unable to access pool file '" << pool_file << "'." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    fileReport << "rank;cost;gap;utilization;file;" << std::endl;
+    for (unsigned int r = 0; r < pool.size(); r++){
+        fileReport << r + 1 << ";"
+                   << poolCosts[r] << ";"
+                   << (poolCosts[r] - poolCosts[0]) / std::max(1.0, std::fabs(poolCosts[0])) << ";"
+                   << getPeakUtilization(pool[r]) << ";"
+                   << insertSuffix(placement_file, "_" + std::to_string(r + 1)) << ";" << std::endl;
+    }
+    fileReport.close();
+    std::cout << "=> Pool written to " << pool_file << "." << std::endl;
+}
+
 /****************************************************************************************/
 /*										Destructors 									*/
 /****************************************************************************************/
 Model::~Model(){
-}
\ No newline at end of file
+    delete callback;
+    values.end();
+    columns.end();
+}
@@ -12,6 +12,8 @@ ILOSTLBEGIN
 
 /*** Own Libraries ***/
 #include "../instance/data.hpp"
+#include "../instance/conditioning.hpp"
+#include "../instance/symmetry.hpp"
 #include "../tools/others.hpp"
 
 /****************************************************************************************/
@@ -37,6 +39,11 @@ typedef std::vector<IloNum4DMatrix>    IloNum5DMatrix;
 #define EPS 1e-4 			// Tolerance, about float precision
 #define EPSILON 1e-6 		// Tolerance, about float precision
 #define BIG_EPSILON 1e-10 	// Tolerance, about float precision
+#define FIXING_TOLERANCE 1e-9 	// Relative tolerance on link capacities and on the gap used by reduced-cost fixing
+#define POOL_INTENSITY 4 		// Solution pool intensity: 4 enumerates the placements within the pool gap
+#define POOL_POPULATE_FACTOR 10 // Number of solutions populate may generate per placement asked for
+
+class CoverCutCallback;
 
 
 /********************************************************************************************
@@ -53,25 +60,47 @@ class Model
 
 		/*** Formulation specific ***/
 		const Data&     data;   		/**< Data read in data.hpp **/
+		std::vector<int> demands;		/**< Demands handled by the model. **/
+		Conditioning 	conditioning;	/**< Units in which throughputs, capacities and costs are written. **/
 		IloObjective    obj;            /**< Objective function **/
-		IloRangeArray   constraints;    /**< Set of constraints **/
+		double 			objectiveScale;	/**< Unit of the objective: the cost unit, or 1 for the peak utilization. **/
+		IloRangeArray   constraints;    /**< Set of constraints: placement rows (one per demand, in order), then capacity rows, then symmetry rows. **/
+		std::vector<int> capacityRowLinks;	/**< Link of each capacity row, in the order of the rows. **/
+		std::vector<std::pair<int, int> > symmetryRowNodes;	/**< Nodes ordered by each symmetry row, in the order of the rows. **/
 
 		/*** Formulation variables ***/
 		IloNumVarMatrix 	x_cu;           /**< Central Unit placement variables **/
 		IloNumVarMatrix 	x_du;           /**< Distributed Unit placement variables **/
-		IloNumVar3DMatrix 	z;           	/**< Total placement variables. z[i][j][k] = 1 if demand i has a DU in node j and CU in node k. **/
+		IloNumVarMatrix 	z;           	/**< Total placement variables. z[i][c] = 1 if demand i has its DU and CU on the nodes of its c-th placement candidate. **/
 		IloNumVar4DMatrix 	concurrent;     /**< Concurrent placement variables. [i1][i2][j][k] = 1 if demand i1 and demand i2 have both a DU in node j and CU in node k. **/
+		IloNumVar 			utilization;	/**< Peak link utilization, bounding the load over capacity of every link (Pareto sweep only). **/
+
+		/*** Solution ***/
+		IloNumVarArray 		columns;		/**< Every z column, demand by demand, in candidate order. **/
+		std::vector<int> 	columnStart;	/**< Position in columns of the first column of each handled demand (size: demands + 1). **/
+		IloNumArray 		values;			/**< Values of the columns, read in a single call after solving (empty if no solution). **/
+		std::vector<std::string> conflict;	/**< Rows of the minimal conflict found when the model is infeasible, explained. **/
+		double 				startCost;		/**< Cost of the cheapest complete MIP start that fits the link capacities (DBL_MAX if none). **/
+		std::vector<std::vector<int> > starts;	/**< Placements installed as MIP starts, kept to install them again after the relaxation. **/
+		int 				nbFixed;		/**< Number of z columns fixed to 0 by reduced-cost fixing (-1 if not run). **/
+		IloNum 				fixingTime;		/**< Time (in seconds) spent on reduced-cost fixing, root LP included. **/
+		std::vector<std::vector<int> > pool;	/**< Best distinct placements of the solution pool, cheapest first (empty if none). **/
+		std::vector<double> poolCosts;		/**< Cost of each placement of the pool. **/
 
 		/*** Manage execution and control ***/
+		CoverCutCallback* callback;					/**< Separates cover cuts on the link capacity rows (none if null). **/
+		std::string exportFile;						/**< File where the model is exported before solving (none if empty). **/
 		IloNum time;
+		std::vector<std::string> buildStepNames;	/**< Names of the model building steps, in execution order. **/
+		std::vector<IloNum> 	 buildStepTimes;	/**< Time (in seconds) spent on each model building step. **/
 
 	public:
 	/****************************************************************************************/
 	/*										Constructors									*/
 	/****************************************************************************************/
-		/** Constructor. Builds the model (variables, objective function, constraints and further parameters). **/
-		Model(const IloEnv& env, const Data& data);
-		Model(const IloEnv& env, const Data&&) = delete;
+		/** Constructor. Builds the model (variables, objective function, constraints and further parameters) for the given demands (every demand if empty). **/
+		Model(const IloEnv& env, const Data& data, const std::vector<int>& demands = std::vector<int>());
+		Model(const IloEnv& env, const Data&&, const std::vector<int>& demands = std::vector<int>()) = delete;
 		Model() = delete;
 
 	/****************************************************************************************/
@@ -86,18 +115,24 @@ class Model
         /** Set up the distributed unit placement variables. **/
         void setDistributedUnitPlacementVariables(const int NB_DEMANDS, const int NB_NODES);
 
-        /** Set up the linearization variables z. **/
+        /** Set up the linearization variables z, one per placement candidate. **/
         void setLinearizationVariables(const int NB_DEMANDS, const int NB_NODES);
 
         /** Set up the concurrent variables. **/
         void setConcurrentVariables(const int NB_DEMANDS, const int NB_NODES);
 
+        /** Set up the peak utilization variable, linked to every capacity row (Pareto sweep only). **/
+        void setUtilizationVariable();
+
 	/****************************************************************************************/
 	/*									Objective Function									*/
 	/****************************************************************************************/
         /** Set up the objective function. **/
         void setObjective();
 
+        /** Minimizes either the peak utilization or the placement cost. @param minimizeUtilization True for the peak utilization. **/
+        void setUtilizationObjective(const bool minimizeUtilization);
+
 	/****************************************************************************************/
 	/*										Constraints										*/
 	/****************************************************************************************/
@@ -115,6 +150,9 @@ class Model
 		/* Set up the link capacity constraints: for each network link, the aggregated throughput must be smaller than its capacity */
 		void setLinkCapacityConstraints();
 
+        /** Set up the symmetry-breaking constraints: inside each orbit of interchangeable nodes, the throughput hosted by the nodes is non-increasing. **/
+        void setSymmetryBreakingConstraints();
+
         void setConcurrentConstraints();
         void setDelayConstraints();
 		// void setPlacementDUConstraints();
@@ -127,18 +165,129 @@ class Model
         /** Set up the Cplex parameters. **/
         void setCplexParameters();
 
+        /** Set up the callback separating lifted cover cuts on the link capacity rows. **/
+        void setCoverCuts();
+
+	/****************************************************************************************/
+	/*										   Getters  									*/
+	/****************************************************************************************/
+		/** Returns a reference to the Concert model. **/
+		const IloModel& getModel() const { return model; }
+
+		/** Returns a reference to the Cplex object. **/
+		const IloCplex& getCplex() const { return cplex; }
+
+		/** Returns the time (in seconds) spent on the last call to run(). **/
+		const IloNum& getTime() const { return time; }
+
+		/** Returns the demands handled by the model. **/
+		const std::vector<int>& getDemands() const { return demands; }
+
+		/** Returns the units in which the model is written. **/
+		const Conditioning& getConditioning() const { return conditioning; }
+
+		/** Returns the objective value of the solution, in original units. **/
+		double getObjValue() const { return cplex.getObjValue() * objectiveScale; }
+
+		/** Returns the best bound on the objective, in original units. **/
+		double getBestObjValue() const { return cplex.getBestObjValue() * objectiveScale; }
+
+		/** Returns true if the values of the columns were read after solving. **/
+		bool isSolutionAvailable() const { return values.getSize() > 0; }
+
+		/** Returns the placement variables: z[i][c] for the c-th candidate of demand i. **/
+		const IloNumVarMatrix& getPlacementVariables() const { return z; }
+
+		/** Returns the chosen candidate of each demand handled by the model (-1 for the others). **/
+		std::vector<int> getPlacement() const;
+
+		/** Returns the placement cost of the solution (0 if none). **/
+		double getPlacementCost() const;
+
+		/** Returns the largest load over capacity among the links used by the solution (0 if none). **/
+		double getPeakUtilization() const;
+
+		/** Returns the largest load over capacity among the links used by the given placement. @param placement The chosen candidate of each demand (-1 if none). **/
+		double getPeakUtilization(const std::vector<int>& placement) const;
+
+		/** Returns the best distinct placements of the solution pool, cheapest first (empty if none). **/
+		const std::vector<std::vector<int> >& getPool() const { return pool; }
+
+		/** Returns the cost of each placement of the pool. **/
+		const std::vector<double>& getPoolCosts() const { return poolCosts; }
+
+		/** Returns the names of the model building steps, in execution order. **/
+		const std::vector<std::string>& getBuildStepNames() const { return buildStepNames; }
+
+		/** Returns the time (in seconds) spent on each model building step. **/
+		const std::vector<IloNum>& getBuildStepTimes() const { return buildStepTimes; }
+
+		/** Returns the rows of the minimal conflict found when the model is infeasible (empty if none). **/
+		const std::vector<std::string>& getConflict() const { return conflict; }
+
+		/** Returns the number of z columns fixed to 0 by reduced-cost fixing (-1 if not run). **/
+		const int& getNbFixed() const { return nbFixed; }
+
+		/** Returns the cost of the placement if every handled demand is placed and the link capacities are met (DBL_MAX otherwise). @param placement The chosen candidate of each demand. **/
+		double getStartCost(const std::vector<int>& placement) const;
+
+		/** Returns the callback separating cover cuts (null if none). **/
+		const CoverCutCallback* getCallback() const { return callback; }
+
 	/****************************************************************************************/
 	/*										   Methods  									*/
 	/****************************************************************************************/
-		/** Solves the MIP. **/
+		/** Records the time spent on a model building step. @param name The step name. @param start The Cplex time at which the step started. **/
+		void addBuildStep(const std::string& name, const IloNum start);
+
+		/** Limits the number of threads used by Cplex. **/
+		void setThreads(const int nbThreads);
+
+		/** Limits the time (in seconds) of the next solves. **/
+		void setTimeLimit(const double seconds);
+
+		/** Sets the file where the model is exported before solving (none if empty). **/
+		void setExportFile(const std::string& file) { exportFile = file; }
+
+		/** Turns off the Cplex log. **/
+		void setQuiet();
+
+		/** Bounds the peak utilization of the links (Pareto sweep only). @param epsilon The largest load over capacity allowed on any link. **/
+		void setUtilizationLimit(const double epsilon) { utilization.setUB(epsilon); }
+
+		/** Installs the given placement (chosen candidate of each demand, -1 if none) as a MIP start. Demands not handled by the model are ignored. **/
+		void setMipStart(const std::vector<int>& placement);
+
+		/** Adds the given placement to the MIP starts of Cplex. **/
+		void addMipStart(const std::vector<int>& placement);
+
+		/** Solves the linear relaxation of the model in place: the z columns are relaxed by a conversion that is removed afterwards. Returns true if it was solved to optimality. @param fractional Filled with the value of each candidate of each demand (empty for the demands not handled). @param value Filled with the LP value, in original units. @param reducedCosts Filled with the reduced cost of each candidate of each demand, in original units (if not null). **/
+		bool solveRelaxation(std::vector<std::vector<double> >& fractional, double& value, std::vector<std::vector<double> >* reducedCosts = NULL);
+
+		/** Rounds the relaxation into a placement: demands are fixed in decreasing order of their largest value, each on its largest-valued candidate that fits the residual capacities. Returns the placement (empty if some demand found no candidate). @param fractional The value of each candidate of each demand. **/
+		std::vector<int> roundRelaxation(const std::vector<std::vector<double> >& fractional) const;
+
+		/** Solves the root LP in place and fixes to 0 every z column whose reduced cost exceeds the gap between the best known placement (the MIP start, or the rounded LP) and the LP value. **/
+		void fixByReducedCosts();
+
+		/** Solves the MIP (after reduced-cost fixing, if asked) and reads the values of every column in a single call. If the model is infeasible, refines a minimal conflict. **/
 		void run();
 
+		/** Reads the placements of the solution pool and keeps the poolSize cheapest distinct ones within the pool gap of the best. **/
+		void readPool();
+
+		/** Runs the conflict refiner on the placement, capacity and symmetry rows and explains the conflict by the demands, links and nodes involved. **/
+		void refineConflict();
+
 		/** Displays the obtained results **/
 		void printResult();
 
 		/** Outputs the obtained results **/
 		void output();
 
+		/** Writes the cost, gap and peak utilization of each placement of the pool next to the placement file, whose name is given the suffix '_pool'. **/
+		void outputPool() const;
+
 	/****************************************************************************************/
 	/*										Destructors 									*/
 	/****************************************************************************************/
@@ -0,0 +1,323 @@
+#include "online.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+Online::Online(const Data& data_) : data(data_), version(0), stopping(false), nbAdmitted(0), nbRejected(0),
+                                    nbDepartures(0), nbReoptimizations(0), nbSwaps(0), time(0.0)
+{
+    /* Candidates of each demand by increasing cost: an admission stops at the first one that fits. */
+    index.resize(data.getNbDemands());
+    for (int i = 0; i < data.getNbDemands(); i++){
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            index[i].push_back(c);
+        }
+        std::stable_sort(index[i].begin(), index[i].end(),
+                         [&candidates](const int a, const int b){ return candidates[a].getCost() < candidates[b].getCost(); });
+    }
+
+    state.placement.assign(data.getNbDemands(), -1);
+    state.residual.resize(data.getNbLinks());
+    for (unsigned int l = 0; l < state.residual.size(); l++){
+        state.residual[l] = data.getLink(l).getCapacity();
+    }
+    state.cost = 0.0;
+
+    readTraceFile(data.getInput().getOnlineTrace());
+}
+
+/****************************************************************************************/
+/*										Getters											*/
+/****************************************************************************************/
+
+/* Returns the p-th percentile (p in [0, 100]) of the admission latencies, in microseconds. */
+double Online::getLatencyPercentile(const double p) const
+{
+    if (latencies.empty()){
+        return 0.0;
+    }
+    std::vector<double> sorted = latencies;
+    std::sort(sorted.begin(), sorted.end());
+    int rank = (int)std::ceil(p / 100.0 * sorted.size()) - 1;
+    rank = std::max(0, std::min((int)sorted.size() - 1, rank));
+    return sorted[rank];
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Reads the replay trace: one line per event, time;event;demand; with event 'arrive' or 'depart'. */
+void Online::readTraceFile(const std::string& filename)
+{
+    std::cout << "=> Reading online trace " << filename << " ..." << std::endl;
+    Reader reader(filename);
+    std::vector<std::vector<std::string> > dataList = reader.getData();
+    // skip the first line (headers)
+    for (unsigned int row = 1; row < dataList.size(); row++){
+        if (dataList[row].size() < 3 || dataList[row][0].empty()){
+            continue;
+        }
+        OnlineEvent event;
+        event.time = atof(dataList[row][0].c_str());
+        if (dataList[row][1] == "arrive"){
+            event.arrival = true;
+        }
+        else if (dataList[row][1] == "depart"){
+            event.arrival = false;
+        }
+        else{
+            std::cerr << "ERROR: Unknown event '" << dataList[row][1] << "' in online trace. Please choose between 'arrive' and 'depart'." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        event.demand = data.getIdFromDemandName(dataList[row][2]);
+        if (event.demand < 0){
+            std::cerr << "ERROR: Could not find a demand with name '" << dataList[row][2] << "' in online trace... Abort." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+        events.push_back(event);
+    }
+    std::stable_sort(events.begin(), events.end(), [](const OnlineEvent& a, const OnlineEvent& b){ return a.time < b.time; });
+    std::cout << "\t " << events.size() << " event(s) were read." << std::endl;
+}
+
+/* Places the i-th demand on its cheapest candidate that fits. Returns false if none fits. */
+bool Online::admit(const int i)
+{
+    const std::vector<Candidate>& candidates = data.getCandidates(i);
+    double lambda = data.getDemand(i).getThroughput();
+    std::lock_guard<std::mutex> lock(mutex);
+    if (state.placement[i] >= 0){
+        return true;
+    }
+    for (unsigned int k = 0; k < index[i].size(); k++){
+        const std::vector<int>& links = candidates[index[i][k]].getListOfLinks();
+        bool fits = true;
+        for (unsigned int l = 0; l < links.size() && fits; l++){
+            fits = (state.residual[links[l]] + ONLINE_TOLERANCE >= lambda);
+        }
+        if (fits){
+            for (unsigned int l = 0; l < links.size(); l++){
+                state.residual[links[l]] -= lambda;
+            }
+            state.placement[i] = index[i][k];
+            state.cost += candidates[index[i][k]].getCost();
+            version++;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Removes the i-th demand and gives its capacity back. */
+void Online::depart(const int i)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (state.placement[i] < 0){
+        return;
+    }
+    const Candidate& candidate = data.getCandidates(i)[state.placement[i]];
+    double lambda = data.getDemand(i).getThroughput();
+    for (unsigned int l = 0; l < candidate.getListOfLinks().size(); l++){
+        state.residual[candidate.getListOfLinks()[l]] += lambda;
+    }
+    state.cost -= candidate.getCost();
+    state.placement[i] = -1;
+    version++;
+}
+
+/* Solves the model over the admitted demands and swaps the result in if it is cheaper. */
+void Online::reoptimize()
+{
+    std::vector<int> snapshot;
+    long snapshotVersion;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        snapshot = state.placement;
+        snapshotVersion = version;
+    }
+    std::vector<int> demands;
+    for (int i = 0; i < data.getNbDemands(); i++){
+        if (snapshot[i] >= 0){
+            demands.push_back(i);
+        }
+    }
+    if (demands.empty()){
+        return;
+    }
+
+    /* The model only covers the admitted demands and starts from their current placement. */
+    std::vector<int> placement;
+    IloEnv env;
+    try
+    {
+        Model model(env, data, demands);
+        model.setQuiet();
+        model.setExportFile("");
+        model.setTimeLimit(std::max(1.0, data.getInput().getReoptimizePeriod()));
+        if (data.getInput().getNbThreads() > 0){
+            model.setThreads(data.getInput().getNbThreads());
+        }
+        model.setMipStart(snapshot);
+        model.run();
+        if (model.isSolutionAvailable()){
+            placement = model.getPlacement();
+        }
+    }
+    catch (const IloException& e) { std::cerr << "Exception caught during re-optimization: " << e << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught during re-optimization!" << std::endl; }
+    env.end();
+    if (placement.empty()){
+        return;
+    }
+
+    /* The next state is built aside and swapped in at once. Demands that arrived since the snapshot keep their candidate. */
+    std::lock_guard<std::mutex> lock(mutex);
+    nbReoptimizations++;
+    OnlineState next;
+    next.placement.assign(data.getNbDemands(), -1);
+    next.residual.resize(data.getNbLinks());
+    for (unsigned int l = 0; l < next.residual.size(); l++){
+        next.residual[l] = data.getLink(l).getCapacity();
+    }
+    next.cost = 0.0;
+    for (int i = 0; i < data.getNbDemands(); i++){
+        if (state.placement[i] < 0){
+            continue;
+        }
+        int c = (placement[i] >= 0) ? placement[i] : state.placement[i];
+        const Candidate& candidate = data.getCandidates(i)[c];
+        double lambda = data.getDemand(i).getThroughput();
+        for (unsigned int l = 0; l < candidate.getListOfLinks().size(); l++){
+            next.residual[candidate.getListOfLinks()[l]] -= lambda;
+        }
+        next.placement[i] = c;
+        next.cost += candidate.getCost();
+    }
+    if (version != snapshotVersion){
+        for (unsigned int l = 0; l < next.residual.size(); l++){
+            if (next.residual[l] < -ONLINE_TOLERANCE){
+                return;
+            }
+        }
+    }
+    if (next.cost < state.cost - ONLINE_TOLERANCE){
+        std::swap(state, next);
+        nbSwaps++;
+    }
+}
+
+/* Re-optimizes every period until the replay is over. */
+void Online::reoptimizeLoop()
+{
+    std::chrono::duration<double> period(data.getInput().getReoptimizePeriod());
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!stopping){
+        if (wake.wait_for(lock, period, [this]{ return stopping; })){
+            break;
+        }
+        lock.unlock();
+        reoptimize();
+        lock.lock();
+    }
+}
+
+/* Replays the trace. */
+void Online::run()
+{
+    std::cout << "=> Replaying " << events.size() << " event(s) ..." << std::endl;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    stopping = false;
+    std::thread reoptimizer;
+    if (data.getInput().getReoptimizePeriod() > 0.0){
+        reoptimizer = std::thread(&Online::reoptimizeLoop, this);
+    }
+
+    for (unsigned int e = 0; e < events.size(); e++){
+        std::this_thread::sleep_until(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(events[e].time)));
+        if (events[e].arrival){
+            std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+            bool admitted = admit(events[e].demand);
+            latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - begin).count());
+            if (admitted){
+                nbAdmitted++;
+            }
+            else{
+                nbRejected++;
+            }
+        }
+        else{
+            depart(events[e].demand);
+            nbDepartures++;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    if (reoptimizer.joinable()){
+        reoptimizer.join();
+    }
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* Displays the obtained results. */
+void Online::printResult()
+{
+    std::cout << "=> Printing solution ..." << std::endl;
+    for (int i = 0; i < data.getNbDemands(); i++){
+        if (state.placement[i] < 0){
+            continue;
+        }
+        const Candidate& candidate = data.getCandidates(i)[state.placement[i]];
+        std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
+        std::cout << "Placement for demand " << data.getDemand(i).getName() << " is : ";
+        std::cout << "(" << data.getNode(candidate.getDU()).getName() << "," << data.getNode(candidate.getCU()).getName() << ")" << ", " << std::endl;
+    }
+    std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
+
+    std::cout << "Admitted: " << nbAdmitted << ", rejected: " << nbRejected << ", departures: " << nbDepartures << std::endl;
+    std::cout << "Placement cost: " << state.cost << std::endl;
+    std::cout << "Re-optimizations: " << nbReoptimizations << " (" << nbSwaps << " swapped in)" << std::endl;
+    std::cout << "Admission latency (us): p50 " << getLatencyPercentile(50) << ", p90 " << getLatencyPercentile(90)
+              << ", p99 " << getLatencyPercentile(99) << ", p99.9 " << getLatencyPercentile(99.9)
+              << ", max " << getLatencyPercentile(100) << std::endl;
+    std::cout << "Total time: " << time << std::endl << std::endl;
+}
+
+/* Outputs the obtained results. */
+void Online::output()
+{
+    std::string output_file = data.getInput().getOutputFile();
+    if (output_file.empty()){
+        return;
+    }
+
+    std::ofstream fileReport(output_file, std::ios_base::app); // File report
+    // If file_output can't be opened
+    if(!fileReport)
+    {
+        std::cerr << "ERROR: Unable to access output file." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::string demand_name = getInBetweenString(data.getInput().getDemandFile(), "/", ".");
+    std::string node_name = getInBetweenString(data.getInput().getNodeFile(), "/", ".");
+    std::string instance_name = node_name + "_" + demand_name;
+
+    fileReport << instance_name << ";"
+               << time << ";"
+               << state.cost << ";"
+               << nbAdmitted << ";"
+               << nbRejected << ";"
+               << getLatencyPercentile(50) << ";"
+               << getLatencyPercentile(99) << ";"
+               << std::endl;
+
+    // Finalization ***
+    fileReport.close();
+}
@@ -0,0 +1,121 @@
+#ifndef __online__hpp
+#define __online__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/*** Own Libraries ***/
+#include "model.hpp"
+
+/****************************************************************************************/
+/*										CONSTANTS										*/
+/****************************************************************************************/
+#define ONLINE_TOLERANCE 	1e-6 	// Residual capacity allowed to go below zero before a link is full
+
+
+/********************************************************************************************
+ * This structure stores one event of a replay trace: the arrival or the departure of a demand.
+********************************************************************************************/
+struct OnlineEvent {
+	double 	time;		/**< Time (in seconds from the start of the replay) of the event. **/
+	bool 	arrival;	/**< True for an arrival, false for a departure. **/
+	int 	demand;		/**< Index of the demand. **/
+};
+
+/********************************************************************************************
+ * This structure stores the state of the online engine: the placement of the admitted
+ * demands and the residual capacity of each link under this placement.
+********************************************************************************************/
+struct OnlineState {
+	std::vector<int> 		placement;	/**< Chosen candidate of each demand (-1 if not admitted). **/
+	std::vector<double> 	residual;	/**< Residual capacity of each link. **/
+	double 					cost;		/**< Placement cost of the admitted demands. **/
+};
+
+/********************************************************************************************
+ * This class places demands arriving one at a time, without solving a MIP. The candidates
+ * of each demand are indexed once by increasing cost; an arriving demand takes the first
+ * of them whose links all have enough residual capacity, and a departing demand gives its
+ * capacity back. A background thread periodically solves the model over the demands
+ * admitted so far, starting from their current placement, and swaps the result in under
+ * the same lock as the admissions whenever it is cheaper and still fits the demands that
+ * arrived or left in the meantime. A trace of arrivals and departures is replayed at its
+ * own pace, and the latency of each admission is recorded.
+********************************************************************************************/
+class Online
+{
+	private:
+		const Data&     					data;   		/**< Data read in data.hpp **/
+		std::vector<std::vector<int> > 		index;			/**< Candidates of each demand, by increasing cost. **/
+		std::vector<OnlineEvent> 			events;			/**< Events of the replay trace, by increasing time. **/
+
+		OnlineState 						state;			/**< Current placement, guarded by mutex. **/
+		long 								version;		/**< Number of admissions and departures applied to state. **/
+		std::mutex 							mutex;			/**< Guards state, version and stopping. **/
+		std::condition_variable 			wake;			/**< Wakes the re-optimization thread up when the replay ends. **/
+		bool 								stopping;		/**< True once the replay is over. **/
+
+		std::vector<double> 				latencies;		/**< Latency (in microseconds) of each admission. **/
+		int 								nbAdmitted;		/**< Number of demands admitted. **/
+		int 								nbRejected;		/**< Number of demands rejected for lack of capacity. **/
+		int 								nbDepartures;	/**< Number of departures. **/
+		int 								nbReoptimizations;	/**< Number of background re-optimizations. **/
+		int 								nbSwaps;		/**< Number of re-optimized placements swapped in. **/
+		double 								time;			/**< Wall time (in seconds) spent on the replay. **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. Builds the candidate index and reads the replay trace. **/
+		Online(const Data& data);
+		Online(const Data&&) = delete;
+		Online() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns the chosen candidate of each demand at the end of the replay (-1 if not admitted). **/
+		const std::vector<int>& getPlacement() const { return state.placement; }
+
+		/** Returns the p-th percentile (p in [0, 100]) of the admission latencies, in microseconds. **/
+		double getLatencyPercentile(const double p) const;
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Reads the replay trace: one line per event, time;event;demand; with event 'arrive' or 'depart'. **/
+		void readTraceFile(const std::string& filename);
+
+		/** Places the i-th demand on its cheapest candidate that fits. Returns false if none fits. **/
+		bool admit(const int i);
+
+		/** Removes the i-th demand and gives its capacity back. **/
+		void depart(const int i);
+
+		/** Solves the model over the admitted demands and swaps the result in if it is cheaper. **/
+		void reoptimize();
+
+		/** Re-optimizes every period until the replay is over. **/
+		void reoptimizeLoop();
+
+		/** Replays the trace. **/
+		void run();
+
+		/** Displays the obtained results. **/
+		void printResult();
+
+		/** Outputs the obtained results. **/
+		void output();
+};
+
+
+#endif
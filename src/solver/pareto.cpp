@@ -0,0 +1,133 @@
+#include "pareto.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+Pareto::Pareto(const Data& data_) : data(data_), time(0.0)
+{
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Solves the model under its current objective and utilization limit, and records the point. */
+ParetoPoint Pareto::solve(Model& model, const double epsilon) const
+{
+    model.run();
+    const IloCplex& cplex = model.getCplex();
+    ParetoPoint point;
+    point.epsilon = epsilon;
+    point.status = cplex.getStatus();
+    point.hasSolution = model.isSolutionAvailable();
+    point.cost = model.getPlacementCost();
+    point.utilization = model.getPeakUtilization();
+    point.bound = point.hasSolution ? model.getBestObjValue() : 0.0;
+    point.time = model.getTime();
+    return point;
+}
+
+/* Sweeps the frontier. */
+void Pareto::run()
+{
+    std::cout << "=> Sweeping the cost versus peak utilization frontier over " << data.getInput().getParetoPoints() << " point(s) ..." << std::endl;
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    points.clear();
+
+    IloEnv env;
+    try
+    {
+        Model model(env, data);
+        model.setExportFile("");
+
+        /* Lowest peak utilization reachable: the left end of the frontier. */
+        model.setUtilizationObjective(true);
+        model.run();
+        if (!model.isSolutionAvailable()){
+            std::cout << "\t No feasible placement found." << std::endl;
+            env.end();
+            return;
+        }
+        double lowest = model.getPeakUtilization();
+        std::vector<int> start = model.getPlacement();
+        std::cout << "\t Lowest peak utilization: " << lowest << std::endl;
+
+        /* Cheapest placement: the right end of the frontier. */
+        model.setUtilizationObjective(false);
+        model.setMipStart(start);
+        ParetoPoint cheapest = solve(model, 1.0);
+        double highest = cheapest.hasSolution ? cheapest.utilization : 1.0;
+        cheapest.epsilon = highest;
+        std::cout << "\t Cheapest placement: cost " << cheapest.cost << ", peak utilization " << highest << std::endl;
+
+        /* Points in between, by increasing epsilon: the previous placement stays feasible and starts the next solve. */
+        const int NB_POINTS = data.getInput().getParetoPoints();
+        for (int k = 0; k + 1 < NB_POINTS; k++){
+            double epsilon = lowest + (highest - lowest) * k / (NB_POINTS - 1);
+            model.setUtilizationLimit(std::min(1.0, epsilon + PARETO_TOLERANCE));
+            model.setMipStart(start);
+            ParetoPoint point = solve(model, epsilon);
+            if (point.hasSolution){
+                start = model.getPlacement();
+            }
+            std::cout << "\t Point " << k + 1 << "/" << NB_POINTS << ": epsilon " << epsilon << ", cost " << point.cost
+                      << ", peak utilization " << point.utilization << ", time " << point.time << std::endl;
+            points.push_back(point);
+        }
+        points.push_back(cheapest);
+    }
+    catch (const IloException& e) { std::cerr << "Exception caught: " << e << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught!" << std::endl; }
+    env.end();
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+/* Displays the frontier. */
+void Pareto::printResult()
+{
+    std::cout << "=> Printing frontier ..." << std::endl;
+    std::cout << "\t epsilon ; cost ; peak utilization ; bound ; time" << std::endl;
+    for (unsigned int k = 0; k < points.size(); k++){
+        std::cout << "\t " << points[k].epsilon << " ; ";
+        if (points[k].hasSolution){
+            std::cout << points[k].cost << " ; " << points[k].utilization << " ; ";
+        }
+        else{
+            std::cout << "- ; - ; ";
+        }
+        std::cout << points[k].bound << " ; " << points[k].time << std::endl;
+    }
+    std::cout << "Points: " << points.size() << std::endl;
+    std::cout << "Total time: " << time << std::endl << std::endl;
+}
+
+/* Writes the frontier to the Pareto file. */
+void Pareto::output()
+{
+    std::string pareto_file = data.getInput().getParetoFile();
+    if (pareto_file.empty()){
+        return;
+    }
+
+    std::ofstream fileReport(pareto_file, std::ios_base::trunc);
+    if(!fileReport)
+    {
+        std::cerr << "ERROR: Unable to access Pareto file." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    fileReport << "epsilon;cost;utilization;bound;time;status;" << std::endl;
+    for (unsigned int k = 0; k < points.size(); k++){
+        fileReport << points[k].epsilon << ";";
+        if (points[k].hasSolution){
+            fileReport << points[k].cost << ";" << points[k].utilization << ";";
+        }
+        else{
+            fileReport << ";;";
+        }
+        fileReport << points[k].bound << ";" << points[k].time << ";" << points[k].status << ";" << std::endl;
+    }
+    fileReport.close();
+    std::cout << "=> Frontier written to " << pareto_file << "." << std::endl;
+}
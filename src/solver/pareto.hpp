@@ -0,0 +1,82 @@
+#ifndef __pareto__hpp
+#define __pareto__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <chrono>
+
+/*** Own Libraries ***/
+#include "model.hpp"
+
+/****************************************************************************************/
+/*										CONSTANTS										*/
+/****************************************************************************************/
+#define PARETO_TOLERANCE 	1e-9 	// Slack added to each epsilon so that the previous point stays feasible
+
+
+/********************************************************************************************
+ * This structure stores one point of the cost versus peak utilization frontier.
+********************************************************************************************/
+struct ParetoPoint {
+	double 					epsilon;		/**< Largest peak utilization allowed. **/
+	IloAlgorithm::Status 	status;			/**< Cplex status at the end of the solve. **/
+	double 					cost;			/**< Placement cost of the point. **/
+	double 					utilization;	/**< Peak link utilization of the point. **/
+	double 					bound;			/**< Lower bound on the cost under this epsilon. **/
+	double 					time;			/**< Time (in seconds) spent on the solve. **/
+	bool 					hasSolution;	/**< True if a placement was found. **/
+};
+
+/********************************************************************************************
+ * This class sweeps the trade-off between placement cost and peak link utilization with the
+ * epsilon-constraint method. The model is built once, with a peak utilization variable
+ * bounding the load over capacity of every used link. Its two extreme points are found
+ * first: the lowest peak utilization reachable, and the cheapest placement. The points in
+ * between are then solved for increasing epsilons, the upper bound of the utilization
+ * variable, each one started from the placement of the previous point, which stays
+ * feasible since epsilon only grows.
+********************************************************************************************/
+class Pareto
+{
+	private:
+		const Data&     					data;   	/**< Data read in data.hpp **/
+		std::vector<ParetoPoint> 			points;		/**< Points of the frontier, by increasing epsilon. **/
+		double 								time;		/**< Wall time (in seconds) spent on the sweep. **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. **/
+		Pareto(const Data& data);
+		Pareto(const Data&&) = delete;
+		Pareto() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns the points of the frontier, by increasing epsilon. **/
+		const std::vector<ParetoPoint>& getPoints() const { return points; }
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Solves the model under its current objective and utilization limit, and records the point. **/
+		ParetoPoint solve(Model& model, const double epsilon) const;
+
+		/** Sweeps the frontier. **/
+		void run();
+
+		/** Displays the frontier. **/
+		void printResult();
+
+		/** Writes the frontier to the Pareto file. **/
+		void output();
+};
+
+
+#endif
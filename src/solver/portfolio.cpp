@@ -0,0 +1,304 @@
+#include "portfolio.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+Portfolio::Portfolio(const Data& data_) : data(data_), nbThreadsPerModel(1), finished(false), winner(-1), time(0.0)
+{
+    readConfigFile(data.getInput().getPortfolioFile());
+    if (configs.empty()){
+        std::cerr << "ERROR: The portfolio file '" << data.getInput().getPortfolioFile() << "' does not contain any configuration." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    /* Cores are shared among the configurations, which all run at the same time. */
+    int nbThreads = data.getInput().getNbThreads();
+    if (nbThreads <= 0){
+        nbThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    nbThreadsPerModel = std::max(1, nbThreads / (int)configs.size());
+}
+
+/****************************************************************************************/
+/*										Getters											*/
+/****************************************************************************************/
+
+/* Returns the status of the winner. */
+IloAlgorithm::Status Portfolio::getStatus() const
+{
+    if (winner < 0){
+        for (unsigned int k = 0; k < results.size(); k++){
+            if (results[k].status == IloAlgorithm::Infeasible){
+                return IloAlgorithm::Infeasible;
+            }
+        }
+        return IloAlgorithm::Unknown;
+    }
+    return results[winner].status;
+}
+
+/* Returns the cost of the best placement found. */
+double Portfolio::getObjValue() const
+{
+    return (winner < 0) ? 0.0 : results[winner].objective;
+}
+
+/* Returns the best lower bound over all configurations. */
+double Portfolio::getBestObjValue() const
+{
+    if (winner >= 0 && results[winner].status == IloAlgorithm::Optimal){
+        return results[winner].objective;
+    }
+    double bound = -IloInfinity;
+    for (unsigned int k = 0; k < results.size(); k++){
+        bound = std::max(bound, results[k].bound);
+    }
+    return bound;
+}
+
+/* Returns the chosen candidate of each demand in the best placement. */
+std::vector<int> Portfolio::getPlacement() const
+{
+    if (winner < 0){
+        return std::vector<int>(data.getNbDemands(), -1);
+    }
+    return results[winner].placement;
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Reads the configurations from the given file. */
+void Portfolio::readConfigFile(const std::string& filename)
+{
+    std::cout << "=> Reading portfolio file " << filename << " ..." << std::endl;
+    const std::string known[] = {"emphasis", "seed", "heuristicFreq", "cutPasses", "probe", "nodeSelect", "variableSelect", "dive", "rins"};
+    Reader reader(filename);
+    std::vector<std::vector<std::string> > dataList = reader.getData();
+    if (dataList.empty()){
+        return;
+    }
+    std::vector<std::string> header = dataList[0];
+    for (unsigned int col = 1; col < header.size(); col++){
+        if (std::find(std::begin(known), std::end(known), header[col]) == std::end(known)){
+            std::cerr << "ERROR: Unknown setting '" << header[col] << "' in portfolio file." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+    }
+    for (unsigned int row = 1; row < dataList.size(); row++){
+        if (dataList[row].empty() || dataList[row][0].empty()){
+            continue;
+        }
+        PortfolioConfig config;
+        config.name = dataList[row][0];
+        for (unsigned int col = 1; col < dataList[row].size() && col < header.size(); col++){
+            if (!dataList[row][col].empty()){
+                config.settings.push_back(std::make_pair(header[col], std::stoi(dataList[row][col])));
+            }
+        }
+        configs.push_back(config);
+    }
+    std::cout << "\t " << configs.size() << " configuration(s) found." << std::endl;
+}
+
+/* Applies the settings of a configuration to the given Cplex object. */
+void Portfolio::applySettings(IloCplex& cplex, const PortfolioConfig& config) const
+{
+    for (unsigned int s = 0; s < config.settings.size(); s++){
+        const std::string& key = config.settings[s].first;
+        int value = config.settings[s].second;
+        if (key == "emphasis")            { cplex.setParam(IloCplex::Param::Emphasis::MIP, value); }
+        else if (key == "seed")           { cplex.setParam(IloCplex::Param::RandomSeed, value); }
+        else if (key == "heuristicFreq")  { cplex.setParam(IloCplex::Param::MIP::Strategy::HeuristicFreq, value); }
+        else if (key == "cutPasses")      { cplex.setParam(IloCplex::Param::MIP::Limits::CutPasses, value); }
+        else if (key == "probe")          { cplex.setParam(IloCplex::Param::MIP::Strategy::Probe, value); }
+        else if (key == "nodeSelect")     { cplex.setParam(IloCplex::Param::MIP::Strategy::NodeSelect, value); }
+        else if (key == "variableSelect") { cplex.setParam(IloCplex::Param::MIP::Strategy::VariableSelect, value); }
+        else if (key == "dive")           { cplex.setParam(IloCplex::Param::MIP::Strategy::Dive, value); }
+        else if (key == "rins")           { cplex.setParam(IloCplex::Param::MIP::Strategy::RINSHeur, value); }
+    }
+}
+
+/* Builds and solves the model with the k-th configuration. */
+void Portfolio::solve(const int k)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    PortfolioResult& result = results[k];
+    result.status = IloAlgorithm::Unknown;
+    result.objective = 0.0;
+    result.bound = -IloInfinity;
+    result.nbNodes = result.nbNodesLeft = 0;
+    result.hasSolution = false;
+    result.placement.assign(data.getNbDemands(), -1);
+
+    /* Each configuration lives in its own environment so that threads share no Concert object. */
+    IloEnv env;
+    IloCplex::Aborter aborter(env);
+    try
+    {
+        Model model(env, data);
+        model.setThreads(nbThreadsPerModel);
+        model.setExportFile("");
+        if (configs.size() > 1){
+            model.setQuiet();
+        }
+        if (!mipStart.empty()){
+            model.setMipStart(mipStart);
+        }
+        IloCplex cplex = model.getCplex();
+        applySettings(cplex, configs[k]);
+        cplex.use(aborter);
+
+        /* A worker that is ready after another one proved optimality does not start. */
+        bool skip = false;
+        {
+            std::lock_guard<std::mutex> lock(abortMutex);
+            skip = finished;
+            aborters[k] = &aborter;
+        }
+        if (!skip){
+            model.run();
+        }
+        {
+            std::lock_guard<std::mutex> lock(abortMutex);
+            aborters[k] = NULL;
+        }
+
+        if (!skip){
+            result.status = cplex.getStatus();
+            result.hasSolution = model.isSolutionAvailable();
+            if (result.hasSolution){
+                result.objective = model.getObjValue();
+                result.placement = model.getPlacement();
+            }
+            result.bound = model.getBestObjValue();
+            result.nbNodes = cplex.getNnodes();
+            result.nbNodesLeft = cplex.getNnodesLeft();
+        }
+
+        /* The first worker proving optimality stops the others. */
+        if (result.status == IloAlgorithm::Optimal){
+            std::lock_guard<std::mutex> lock(abortMutex);
+            if (!finished){
+                finished = true;
+                winner = k;
+                for (unsigned int w = 0; w < aborters.size(); w++){
+                    if (aborters[w] != NULL){
+                        aborters[w]->abort();
+                    }
+                }
+            }
+        }
+    }
+    catch (const IloException& e) { std::cerr << "Exception caught on configuration " << configs[k].name << ": " << e << std::endl; result.status = IloAlgorithm::Error; }
+    catch (...) { std::cerr << "Unknown exception caught on configuration " << configs[k].name << "!" << std::endl; result.status = IloAlgorithm::Error; }
+    {
+        std::lock_guard<std::mutex> lock(abortMutex);
+        aborters[k] = NULL;
+    }
+    aborter.end();
+    env.end();
+    result.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* Solves every configuration concurrently. */
+void Portfolio::run()
+{
+    std::cout << "=> Running a portfolio of " << configs.size() << " configuration(s) with "
+              << nbThreadsPerModel << " Cplex thread(s) each ..." << std::endl;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    results.assign(configs.size(), PortfolioResult());
+    aborters.assign(configs.size(), NULL);
+    finished = false;
+    winner = -1;
+
+    std::vector<std::thread> workers;
+    for (unsigned int k = 0; k < configs.size(); k++){
+        workers.push_back(std::thread(&Portfolio::solve, this, k));
+    }
+    for (unsigned int k = 0; k < workers.size(); k++){
+        workers[k].join();
+    }
+
+    /* Without a proof of optimality, the best incumbent at the deadline is returned. */
+    if (winner < 0){
+        for (unsigned int k = 0; k < results.size(); k++){
+            if (results[k].hasSolution && (winner < 0 || results[k].objective < results[winner].objective)){
+                winner = k;
+            }
+        }
+    }
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* Displays the obtained results. */
+void Portfolio::printResult()
+{
+    std::cout << "=> Printing solution ..." << std::endl;
+    std::vector<int> placement = getPlacement();
+    for (int i = 0; i < data.getNbDemands(); i++){
+        std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
+        std::cout << "Placement for demand " << data.getDemand(i).getName() << " is : ";
+        if (placement[i] >= 0){
+            const Candidate& candidate = data.getCandidates(i)[placement[i]];
+            std::cout << "(" << data.getNode(candidate.getDU()).getName() << "," << data.getNode(candidate.getCU()).getName() << ")" << ", ";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
+
+    for (unsigned int k = 0; k < results.size(); k++){
+        std::cout << "\t " << configs[k].name << ": status " << results[k].status;
+        if (results[k].hasSolution){
+            std::cout << ", objective " << results[k].objective;
+        }
+        std::cout << ", bound " << results[k].bound << ", nodes " << results[k].nbNodes << ", time " << results[k].time
+                  << ((int)k == winner ? " (winner)" : "") << std::endl;
+    }
+    std::cout << "Status: " << getStatus() << std::endl;
+    std::cout << "Objective value: " << getObjValue() << std::endl;
+    std::cout << "Best bound: " << getBestObjValue() << std::endl;
+    std::cout << "Winner: " << (winner < 0 ? "none" : configs[winner].name) << std::endl;
+    std::cout << "Total time: " << time << std::endl << std::endl;
+}
+
+/* Outputs the obtained results. */
+void Portfolio::output()
+{
+    std::string output_file = data.getInput().getOutputFile();
+    if (output_file.empty()){
+        return;
+    }
+
+    std::ofstream fileReport(output_file, std::ios_base::app); // File report
+    // If file_output can't be opened
+    if(!fileReport)
+    {
+        std::cerr << "ERROR: Unable to access output file." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::string demand_name = getInBetweenString(data.getInput().getDemandFile(), "/", ".");
+    std::string node_name = getInBetweenString(data.getInput().getNodeFile(), "/", ".");
+    std::string instance_name = node_name + "_" + demand_name;
+
+    double objective = getObjValue();
+    double bound = getBestObjValue();
+    double gap = (std::fabs(objective) > 0.0) ? std::fabs(objective - bound) / std::fabs(objective) : 0.0;
+    long nbNodes = (winner < 0) ? 0 : results[winner].nbNodes;
+    long nbNodesLeft = (winner < 0) ? 0 : results[winner].nbNodesLeft;
+
+    fileReport << instance_name << ";"
+               << time << ";"
+               << objective << ";"
+               << bound << ";"
+               << gap*100 << ";"
+               << nbNodes << ";"
+               << nbNodesLeft*0.001 << ";"
+               << std::endl;
+
+    // Finalization ***
+    fileReport.close();
+}
@@ -0,0 +1,124 @@
+#ifndef __portfolio__hpp
+#define __portfolio__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+/*** Own Libraries ***/
+#include "model.hpp"
+
+
+/********************************************************************************************
+ * This structure stores one configuration of the portfolio: a name and the Cplex settings
+ * that differ from the defaults, as (column name, value) pairs of the configuration file.
+********************************************************************************************/
+struct PortfolioConfig {
+	std::string 								name;		/**< Name of the configuration. **/
+	std::vector<std::pair<std::string, int> > 	settings;	/**< Cplex settings given in the file. **/
+};
+
+/********************************************************************************************
+ * This structure stores the outcome of the solve of one configuration.
+********************************************************************************************/
+struct PortfolioResult {
+	IloAlgorithm::Status 	status;			/**< Cplex status at the end of the solve. **/
+	double 					objective;		/**< Cost of the best placement found. **/
+	double 					bound;			/**< Best lower bound. **/
+	long 					nbNodes;		/**< Number of branch-and-bound nodes evaluated. **/
+	long 					nbNodesLeft;	/**< Number of open nodes left. **/
+	double 					time;			/**< Time (in seconds) spent on building and solving. **/
+	bool 					hasSolution;	/**< True if a placement was found. **/
+	std::vector<int> 		placement;		/**< Chosen candidate of each demand (-1 if none). **/
+};
+
+/********************************************************************************************
+ * This class runs a portfolio of differently configured Cplex solves of the same instance
+ * concurrently. The configurations are read from a ';'-separated file whose header names
+ * the settings (name;emphasis;seed;heuristicFreq;cutPasses;probe;nodeSelect;variableSelect;
+ * dive;rins) and where each line is one configuration (an empty cell keeps the default).
+ * Each worker builds its own Model in its own IloEnv with a share of the threads. As soon
+ * as one worker proves optimality, the others are aborted; otherwise the best incumbent
+ * and the best bound over all workers are returned at the deadline.
+********************************************************************************************/
+class Portfolio
+{
+	private:
+		const Data&     					data;   			/**< Data read in data.hpp **/
+		std::vector<PortfolioConfig> 		configs;			/**< Configurations to be run. **/
+		std::vector<PortfolioResult> 		results;			/**< Outcome of each configuration. **/
+		std::vector<int> 					mipStart;			/**< Placement installed as MIP start in each worker (empty if none). **/
+		int 								nbThreadsPerModel;	/**< Number of Cplex threads given to each configuration. **/
+		std::mutex 							abortMutex;			/**< Protects the aborters and the winner. **/
+		std::vector<IloCplex::Aborter*> 	aborters;			/**< Aborter of each running worker (NULL if not running). **/
+		bool 								finished;			/**< True once a worker proved optimality. **/
+		int 								winner;				/**< Configuration whose result is returned (-1 if none). **/
+		double 								time;				/**< Wall time (in seconds) spent on the portfolio. **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. Reads the configurations from the portfolio file. **/
+		Portfolio(const Data& data);
+		Portfolio(const Data&&) = delete;
+		Portfolio() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns the number of configurations. **/
+		int getNbConfigs() const { return configs.size(); }
+
+		/** Returns the configuration whose result is returned (-1 if none). **/
+		int getWinner() const { return winner; }
+
+		/** Returns the status: the one of the winner, or unknown if no configuration found a placement. **/
+		IloAlgorithm::Status getStatus() const;
+
+		/** Returns the cost of the best placement found. **/
+		double getObjValue() const;
+
+		/** Returns the best lower bound over all configurations. **/
+		double getBestObjValue() const;
+
+		/** Returns the chosen candidate of each demand in the best placement (-1 if none). **/
+		std::vector<int> getPlacement() const;
+
+	/****************************************************************************************/
+	/*										Setters											*/
+	/****************************************************************************************/
+		/** Sets the placement (chosen candidate of each demand, -1 if none) installed as MIP start in each worker. **/
+		void setMipStart(const std::vector<int>& placement) { mipStart = placement; }
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Reads the configurations from the given file. **/
+		void readConfigFile(const std::string& filename);
+
+		/** Applies the settings of a configuration to the given Cplex object. **/
+		void applySettings(IloCplex& cplex, const PortfolioConfig& config) const;
+
+		/** Builds and solves the model with the k-th configuration. **/
+		void solve(const int k);
+
+		/** Solves every configuration concurrently. **/
+		void run();
+
+		/** Displays the obtained results **/
+		void printResult();
+
+		/** Outputs the obtained results **/
+		void output();
+};
+
+
+#endif
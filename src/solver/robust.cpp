@@ -0,0 +1,257 @@
+#include "robust.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+Robust::Robust(const Data& data_) : data(data_), nbRequired(0), nbThreads(1), status(IloAlgorithm::Unknown),
+                                    objective(0.0), bound(0.0), converged(false), nbIterations(0), nbRows(0), time(0.0)
+{
+    const int NB_SCENARIOS = data.getNbScenarios();
+    nbRequired = (int)std::ceil(data.getInput().getScenarioCoverage() * NB_SCENARIOS - ROBUST_TOLERANCE);
+    nbRequired = std::max(1, std::min(NB_SCENARIOS, nbRequired));
+
+    nbThreads = data.getInput().getNbThreads();
+    if (nbThreads <= 0){
+        nbThreads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+    nbThreads = std::min(nbThreads, NB_SCENARIOS);
+
+    /* Gather the candidates consuming the capacity of each link. */
+    const int NB_LINKS = data.getNbLinks();
+    users.resize(NB_LINKS);
+    for (int i = 0; i < data.getNbDemands(); i++){
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            for (unsigned int l = 0; l < candidates[c].getListOfLinks().size(); l++){
+                users[candidates[c].getListOfLinks()[l]].push_back(std::make_pair(i, (int)c));
+            }
+        }
+    }
+    added.assign(NB_SCENARIOS, std::vector<bool>(NB_LINKS, false));
+    satisfied.assign(NB_SCENARIOS, false);
+    placement.assign(data.getNbDemands(), -1);
+}
+
+/****************************************************************************************/
+/*										Getters											*/
+/****************************************************************************************/
+
+/* Returns the number of scenarios satisfied by the placement. */
+int Robust::getNbSatisfied() const
+{
+    return (int)std::count(satisfied.begin(), satisfied.end(), true);
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Computes the links overloaded by the placement in scenarios [first, last). */
+void Robust::checkScenarios(const int first, const int last, std::vector<std::vector<int> >& violated) const
+{
+    std::vector<double> load(users.size(), 0.0);
+    for (int s = first; s < last; s++){
+        std::fill(load.begin(), load.end(), 0.0);
+        for (int i = 0; i < data.getNbDemands(); i++){
+            if (placement[i] < 0){
+                continue;
+            }
+            const std::vector<int>& links = data.getCandidates(i)[placement[i]].getListOfLinks();
+            for (unsigned int l = 0; l < links.size(); l++){
+                load[links[l]] += data.getScenarioThroughput(i, s);
+            }
+        }
+        violated[s].clear();
+        for (unsigned int l = 0; l < load.size(); l++){
+            if (load[l] > data.getLink(l).getCapacity() + ROBUST_TOLERANCE){
+                violated[s].push_back(l);
+            }
+        }
+    }
+}
+
+/* Solves the model, adding scenario rows until the placement satisfies the required scenarios. */
+void Robust::run()
+{
+    const int NB_SCENARIOS = data.getNbScenarios();
+    std::cout << "=> Solving the placement over " << NB_SCENARIOS << " throughput scenario(s), "
+              << nbRequired << " of which must be satisfied, with " << nbThreads << " checking thread(s) ..." << std::endl;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    IloEnv env;
+    try
+    {
+        Model model(env, data);
+        model.setExportFile("");
+        IloModel master = model.getModel();
+        const IloNumVarMatrix& z = model.getPlacementVariables();
+        const Conditioning& conditioning = model.getConditioning();
+
+        /* Under partial coverage, y[s] = 1 enforces the rows of scenario s. */
+        bool partial = (nbRequired < NB_SCENARIOS);
+        IloNumVarArray y(env);
+        if (partial){
+            IloExpr exp(env);
+            for (int s = 0; s < NB_SCENARIOS; s++){
+                std::string name = "y(" + std::to_string(s) + ")";
+                y.add(IloNumVar(env, 0, 1, ILOBOOL, name.c_str()));
+                exp += y[s];
+            }
+            master.add(IloRange(env, nbRequired, exp, IloInfinity, "Scenario coverage"));
+            exp.end();
+        }
+
+        std::vector<std::vector<int> > violated(NB_SCENARIOS);
+        const double TIME_LIMIT = data.getInput().getTimeLimit();
+        while (true){
+            double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (elapsed >= TIME_LIMIT){
+                std::cout << "\t Time limit reached." << std::endl;
+                break;
+            }
+            model.setTimeLimit(TIME_LIMIT - elapsed);
+            model.run();
+            nbIterations++;
+
+            const IloCplex& cplex = model.getCplex();
+            status = cplex.getStatus();
+            if (!model.isSolutionAvailable()){
+                converged = false;
+                break;
+            }
+            placement = model.getPlacement();
+            objective = model.getPlacementCost();
+            bound = model.getBestObjValue();
+            std::vector<bool> enforced(NB_SCENARIOS, true);
+            if (partial){
+                for (int s = 0; s < NB_SCENARIOS; s++){
+                    enforced[s] = (cplex.getValue(y[s]) > 0.5);
+                }
+            }
+
+            /* Scenarios are checked in parallel, each thread over a contiguous block. */
+            std::vector<std::thread> workers;
+            for (int t = 0; t < nbThreads; t++){
+                int first = (NB_SCENARIOS * t) / nbThreads;
+                int last = (NB_SCENARIOS * (t + 1)) / nbThreads;
+                workers.push_back(std::thread(&Robust::checkScenarios, this, first, last, std::ref(violated)));
+            }
+            for (unsigned int t = 0; t < workers.size(); t++){
+                workers[t].join();
+            }
+
+            /* Rows of the overloaded links are added for the scenarios that have to be satisfied. */
+            int nbNewRows = 0;
+            for (int s = 0; s < NB_SCENARIOS; s++){
+                satisfied[s] = violated[s].empty();
+                if (!enforced[s]){
+                    continue;
+                }
+                for (unsigned int v = 0; v < violated[s].size(); v++){
+                    int l = violated[s][v];
+                    if (added[s][l]){
+                        continue;
+                    }
+                    IloExpr exp(env);
+                    double mu = conditioning.throughput(data.getLink(l).getCapacity());
+                    double bigM = -mu;
+                    int lastDemand = -1;
+                    for (unsigned int u = 0; u < users[l].size(); u++){
+                        int i = users[l][u].first;
+                        double lambda = conditioning.throughput(data.getScenarioThroughput(i, s));
+                        exp += lambda * z[i][users[l][u].second];
+                        /* A demand loads the link through one candidate at most. */
+                        if (i != lastDemand){
+                            bigM += lambda;
+                            lastDemand = i;
+                        }
+                    }
+                    std::string name = "Capacity of link(" + std::to_string(l) + ") in scenario " + std::to_string(s);
+                    if (partial){
+                        exp += bigM * y[s];
+                        master.add(IloRange(env, -IloInfinity, exp, mu + bigM, name.c_str()));
+                    }
+                    else{
+                        master.add(IloRange(env, -IloInfinity, exp, mu, name.c_str()));
+                    }
+                    exp.end();
+                    added[s][l] = true;
+                    nbNewRows++;
+                }
+            }
+            nbRows += nbNewRows;
+            std::cout << "\t Iteration " << nbIterations << ": cost " << objective << ", " << getNbSatisfied() << "/" << NB_SCENARIOS
+                      << " scenario(s) satisfied, " << nbNewRows << " row(s) added." << std::endl;
+            if (nbNewRows == 0){
+                converged = true;
+                break;
+            }
+        }
+        y.end();
+    }
+    catch (const IloException& e) { std::cerr << "Exception caught: " << e << std::endl; converged = false; }
+    catch (...) { std::cerr << "Unknown exception caught!" << std::endl; converged = false; }
+    env.end();
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/* Displays the obtained results. */
+void Robust::printResult()
+{
+    std::cout << "=> Printing solution ..." << std::endl;
+    for (int i = 0; i < data.getNbDemands(); i++){
+        std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
+        std::cout << "Placement for demand " << data.getDemand(i).getName() << " is : ";
+        if (converged && placement[i] >= 0){
+            const Candidate& candidate = data.getCandidates(i)[placement[i]];
+            std::cout << "(" << data.getNode(candidate.getDU()).getName() << "," << data.getNode(candidate.getCU()).getName() << ")" << ", ";
+        }
+        std::cout << std::endl;
+    }
+    std::cout << std::endl << "----------------------------------------------------" << std::endl << std::endl;
+
+    std::cout << "Status: " << status << (converged ? "" : " (no placement satisfies the required scenarios)") << std::endl;
+    std::cout << "Objective value: " << (converged ? objective : 0.0) << std::endl;
+    std::cout << "Best bound: " << bound << std::endl;
+    std::cout << "Scenarios satisfied: " << getNbSatisfied() << "/" << data.getNbScenarios() << " (" << nbRequired << " required)" << std::endl;
+    std::cout << "Iterations: " << nbIterations << std::endl;
+    std::cout << "Scenario rows: " << nbRows << " (out of " << (long)data.getNbScenarios() * data.getNbLinks() << ")" << std::endl;
+    std::cout << "Total time: " << time << std::endl << std::endl;
+}
+
+/* Outputs the obtained results. */
+void Robust::output()
+{
+    std::string output_file = data.getInput().getOutputFile();
+    if (output_file.empty()){
+        return;
+    }
+
+    std::ofstream fileReport(output_file, std::ios_base::app); // File report
+    // If file_output can't be opened
+    if(!fileReport)
+    {
+        std::cerr << "ERROR: Unable to access output file." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+
+    std::string demand_name = getInBetweenString(data.getInput().getDemandFile(), "/", ".");
+    std::string node_name = getInBetweenString(data.getInput().getNodeFile(), "/", ".");
+    std::string instance_name = node_name + "_" + demand_name;
+
+    double value = converged ? objective : 0.0;
+    double gap = (converged && std::fabs(value) > 0.0) ? std::fabs(value - bound) / std::fabs(value) : 0.0;
+
+    fileReport << instance_name << ";"
+               << time << ";"
+               << value << ";"
+               << bound << ";"
+               << gap*100 << ";"
+               << data.getNbScenarios() << ";"
+               << nbRows << ";"
+               << std::endl;
+
+    // Finalization ***
+    fileReport.close();
+}
@@ -0,0 +1,89 @@
+#ifndef __robust__hpp
+#define __robust__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <chrono>
+#include <thread>
+
+/*** Own Libraries ***/
+#include "model.hpp"
+
+/****************************************************************************************/
+/*										CONSTANTS										*/
+/****************************************************************************************/
+#define ROBUST_TOLERANCE 	1e-6 	// Load over capacity allowed before a scenario row is violated
+
+
+/********************************************************************************************
+ * This class finds one placement that respects the link capacities under every throughput
+ * scenario, or under a chosen fraction of them. Writing the capacity rows of all scenarios
+ * would grow the model linearly in their number, so rows are generated instead: the model
+ * starts without capacity rows, each placement found is checked against every scenario in
+ * parallel, and a row is added for each (scenario, link) pair it overloads. The process
+ * stops when a placement overloads no scenario it has to satisfy. When only a fraction of
+ * the scenarios must be satisfied, a binary variable per scenario selects the ones that
+ * are enforced, and their rows are relaxed by a big-M term when not selected.
+********************************************************************************************/
+class Robust
+{
+	private:
+		const Data&     					data;   		/**< Data read in data.hpp **/
+		int 								nbRequired;		/**< Number of scenarios the placement must satisfy. **/
+		int 								nbThreads;		/**< Number of threads checking the scenarios. **/
+		std::vector<std::vector<std::pair<int, int> > > users;	/**< Candidates (demand, candidate) consuming the capacity of each link. **/
+		std::vector<std::vector<bool> > 	added;			/**< True if the row of (scenario, link) is in the model. **/
+
+		IloAlgorithm::Status 				status;			/**< Cplex status of the last solve. **/
+		std::vector<int> 					placement;		/**< Chosen candidate of each demand. **/
+		std::vector<bool> 					satisfied;		/**< True if the placement respects the capacities of the scenario. **/
+		double 								objective;		/**< Cost of the placement. **/
+		double 								bound;			/**< Lower bound of the last solve. **/
+		bool 								converged;		/**< True if the last placement violates no enforced scenario. **/
+		int 								nbIterations;	/**< Number of solves. **/
+		int 								nbRows;			/**< Number of scenario rows added. **/
+		double 								time;			/**< Wall time (in seconds) spent on the solve. **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. **/
+		Robust(const Data& data);
+		Robust(const Data&&) = delete;
+		Robust() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns true if a placement satisfying the required scenarios was found. **/
+		bool hasSolution() const { return converged; }
+
+		/** Returns the chosen candidate of each demand. **/
+		const std::vector<int>& getPlacement() const { return placement; }
+
+		/** Returns the number of scenarios satisfied by the placement. **/
+		int getNbSatisfied() const;
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Computes the links overloaded by the placement in scenarios [first, last). **/
+		void checkScenarios(const int first, const int last, std::vector<std::vector<int> >& violated) const;
+
+		/** Solves the model, adding scenario rows until the placement satisfies the required scenarios. **/
+		void run();
+
+		/** Displays the obtained results. **/
+		void printResult();
+
+		/** Outputs the obtained results. **/
+		void output();
+};
+
+
+#endif
@@ -0,0 +1,332 @@
+#include "rolling.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+RollingHorizon::RollingHorizon(const IloEnv& env_, const Data& data_) : env(env_), data(data_), conditioning(data_), nbPeriods(data_.getNbPeriods()),
+                    horizon(std::min(data_.getInput().getHorizon(), data_.getNbPeriods())), model(env), cplex(model), columns(env), time(0.0)
+{
+    std::cout << "=> Building rolling horizon model over " << horizon << " period(s) ... " << std::endl;
+    build();
+    conditioning.print();
+
+    /* Tuned settings apply to every window; the time limit of the parameter file is shared among the periods. */
+    if (!data.getInput().getCplexParamFile().empty()){
+        cplex.readParam(data.getInput().getCplexParamFile().c_str());
+    }
+    cplex.setParam(IloCplex::Param::TimeLimit, std::max(1.0, (double)data.getInput().getTimeLimit() / nbPeriods));
+    if (data.getInput().getNbThreads() > 0){
+        cplex.setParam(IloCplex::Param::Threads, data.getInput().getNbThreads());
+    }
+    std::cout << "=> Model was correctly built ! " << std::endl;
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Builds the variables, constraints and objective of one window. */
+void RollingHorizon::build()
+{
+    const int NB_DEMANDS = data.getNbDemands();
+    const double PENALTY = conditioning.cost(data.getInput().getReassignmentPenalty());
+
+    /* Placement and move variables of each period of the window. */
+    columnStart.assign(NB_DEMANDS + 1, 0);
+    for (int i = 0; i < NB_DEMANDS; i++){
+        columnStart[i+1] = columnStart[i] + data.getCandidates(i).size();
+    }
+    z.resize(horizon);
+    moved.resize(horizon);
+    for (int t = 0; t < horizon; t++){
+        z[t].resize(NB_DEMANDS);
+        moved[t].resize(NB_DEMANDS);
+        for (int i = 0; i < NB_DEMANDS; i++){
+            for (unsigned int c = 0; c < data.getCandidates(i).size(); c++){
+                std::string name = "z(" + std::to_string(t) + "," + std::to_string(i) + "," + std::to_string(c) + ")";
+                z[t][i].push_back(IloNumVar(env, 0.0, 1.0, ILOINT, name.c_str()));
+                columns.add(z[t][i][c]);
+            }
+            std::string name = "moved(" + std::to_string(t) + "," + std::to_string(i) + ")";
+            moved[t][i] = IloNumVar(env, 0.0, 1.0, ILOFLOAT, name.c_str());
+        }
+    }
+
+    /* Placement costs of every period, and a penalty per move. */
+    IloExpr exp(env);
+    for (int t = 0; t < horizon; t++){
+        for (int i = 0; i < NB_DEMANDS; i++){
+            const std::vector<Candidate>& candidates = data.getCandidates(i);
+            for (unsigned int c = 0; c < candidates.size(); c++){
+                exp += conditioning.cost(candidates[c].getCost()) * z[t][i][c];
+            }
+            exp += PENALTY * moved[t][i];
+        }
+    }
+    IloObjective obj(env);
+    obj.setExpr(exp);
+    obj.setSense(IloObjective::Minimize);
+    model.add(obj);
+    exp.end();
+
+    /* Each demand uses one candidate per period. */
+    for (int t = 0; t < horizon; t++){
+        for (int i = 0; i < NB_DEMANDS; i++){
+            IloExpr placement(env);
+            for (unsigned int c = 0; c < z[t][i].size(); c++){
+                placement += z[t][i][c];
+            }
+            std::string name = "Placement(" + std::to_string(t) + "," + std::to_string(i) + ")";
+            model.add(IloRange(env, 1, placement, 1, name.c_str()));
+            placement.end();
+        }
+    }
+
+    /* A demand moves at period t if it leaves a candidate used at t-1: moved[t][i] >= z[t-1][i][c] - z[t][i][c].
+       At the first period of the window, the committed placement is a constant held in the row bounds. */
+    firstMove.resize(NB_DEMANDS);
+    for (int t = 0; t < horizon; t++){
+        for (int i = 0; i < NB_DEMANDS; i++){
+            for (unsigned int c = 0; c < z[t][i].size(); c++){
+                IloExpr move(env);
+                move += moved[t][i];
+                move += z[t][i][c];
+                std::string name = "Move(" + std::to_string(t) + "," + std::to_string(i) + "," + std::to_string(c) + ")";
+                if (t == 0){
+                    firstMove[i].push_back(IloRange(env, 0, move, IloInfinity, name.c_str()));
+                    model.add(firstMove[i].back());
+                }
+                else{
+                    move -= z[t-1][i][c];
+                    model.add(IloRange(env, 0, move, IloInfinity, name.c_str()));
+                }
+                move.end();
+            }
+        }
+    }
+
+    /* Capacity rows of every period; their throughputs are written by setWindow. */
+    std::vector<std::vector<std::pair<int, int> > > linkUsers(data.getNbLinks());
+    for (int i = 0; i < NB_DEMANDS; i++){
+        const std::vector<Candidate>& candidates = data.getCandidates(i);
+        for (unsigned int c = 0; c < candidates.size(); c++){
+            for (unsigned int l = 0; l < candidates[c].getListOfLinks().size(); l++){
+                linkUsers[candidates[c].getListOfLinks()[l]].push_back(std::make_pair(i, (int)c));
+            }
+        }
+    }
+    for (unsigned int l = 0; l < linkUsers.size(); l++){
+        if (!linkUsers[l].empty()){
+            capacityLinks.push_back(l);
+            users.push_back(linkUsers[l]);
+        }
+    }
+    capacity.resize(horizon);
+    for (int t = 0; t < horizon; t++){
+        for (unsigned int k = 0; k < capacityLinks.size(); k++){
+            IloExpr load(env);
+            for (unsigned int u = 0; u < users[k].size(); u++){
+                load += conditioning.throughput(data.getDemand(users[k][u].first).getThroughput()) * z[t][users[k][u].first][users[k][u].second];
+            }
+            std::string name = "Capacity(" + std::to_string(t) + "," + std::to_string(capacityLinks[k]) + ")";
+            capacity[t].push_back(IloRange(env, -IloInfinity, load, conditioning.throughput(data.getLink(capacityLinks[k]).getCapacity()), name.c_str()));
+            model.add(capacity[t].back());
+            load.end();
+        }
+    }
+}
+
+/* Writes the throughputs of the window starting at the given period into the capacity rows. */
+void RollingHorizon::setWindow(const int first)
+{
+    for (int t = 0; t < horizon; t++){
+        int period = (first + t) % nbPeriods;
+        for (unsigned int k = 0; k < capacityLinks.size(); k++){
+            IloNumVarArray vars(env);
+            IloNumArray vals(env);
+            for (unsigned int u = 0; u < users[k].size(); u++){
+                vars.add(z[t][users[k][u].first][users[k][u].second]);
+                vals.add(conditioning.throughput(data.getPeriodThroughput(users[k][u].first, period)));
+            }
+            capacity[t][k].setLinearCoefs(vars, vals);
+            vars.end();
+            vals.end();
+        }
+    }
+}
+
+/* Ties the first period of the window to the given committed placement (no penalty if empty). */
+void RollingHorizon::setCommitted(const std::vector<int>& placement)
+{
+    /* moved[0][i] + z[0][i][c] >= 1 for the committed candidate c, and >= 0 (always true) for the others. */
+    for (int i = 0; i < data.getNbDemands(); i++){
+        for (unsigned int c = 0; c < firstMove[i].size(); c++){
+            bool committed = (!placement.empty() && placement[i] == (int)c);
+            firstMove[i][c].setLB(committed ? 1.0 : 0.0);
+        }
+    }
+}
+
+/* Installs the given placement of each period of the window as a MIP start. */
+void RollingHorizon::setMipStart(const std::vector<std::vector<int> >& placements)
+{
+    if (cplex.getNMIPStarts() > 0){
+        cplex.deleteMIPStarts(0, cplex.getNMIPStarts());
+    }
+    IloNumArray vals(env, columns.getSize());
+    for (int t = 0; t < horizon; t++){
+        int offset = t * columnStart.back();
+        for (int i = 0; i < data.getNbDemands(); i++){
+            for (int c = columnStart[i]; c < columnStart[i+1]; c++){
+                vals[offset + c] = (c - columnStart[i] == placements[t][i]) ? 1.0 : 0.0;
+            }
+        }
+    }
+    /* The last period of the window is new, so the start may overload it and needs a repair. */
+    cplex.addMIPStart(columns, vals, IloCplex::MIPStartRepair, "rolling");
+    vals.end();
+}
+
+/* Solves every window and commits their first period. */
+void RollingHorizon::run()
+{
+    std::cout << "=> Rolling a horizon of " << horizon << " period(s) over " << nbPeriods << " period(s) ..." << std::endl;
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+    const int NB_DEMANDS = data.getNbDemands();
+    std::vector<int> committed;
+    std::vector<std::vector<int> > previous;
+    IloNumArray values(env);
+
+    for (int p = 0; p < nbPeriods; p++){
+        setWindow(p);
+        setCommitted(committed);
+        /* The previous window, shifted by one period, starts the new one: its last period is repeated. */
+        if (!previous.empty()){
+            std::vector<std::vector<int> > start(previous.begin() + 1, previous.end());
+            start.push_back(previous.back());
+            setMipStart(start);
+        }
+
+        IloNum solveStart = cplex.getCplexTime();
+        cplex.solve();
+        periodTime.push_back(cplex.getCplexTime() - solveStart);
+        periodStatus.push_back(cplex.getStatus());
+        if (cplex.getStatus() != IloAlgorithm::Optimal && cplex.getStatus() != IloAlgorithm::Feasible){
+            std::cout << "\t Period " << p << ": no placement found (status " << cplex.getStatus() << "), the horizon stops here." << std::endl;
+            break;
+        }
+
+        /* All the placement columns of the window are read at once. */
+        cplex.getValues(values, columns);
+        previous.assign(horizon, std::vector<int>(NB_DEMANDS, -1));
+        for (int t = 0; t < horizon; t++){
+            int offset = t * columnStart.back();
+            for (int i = 0; i < NB_DEMANDS; i++){
+                for (int c = columnStart[i]; c < columnStart[i+1]; c++){
+                    if (values[offset + c] > 1 - EPS){
+                        previous[t][i] = c - columnStart[i];
+                    }
+                }
+            }
+        }
+
+        /* Commit the first period of the window. */
+        double cost = 0.0;
+        int moves = 0;
+        for (int i = 0; i < NB_DEMANDS; i++){
+            cost += data.getCandidates(i)[previous[0][i]].getCost();
+            if (!committed.empty() && committed[i] != previous[0][i]){
+                moves++;
+            }
+        }
+        committed = previous[0];
+        schedule.push_back(committed);
+        periodCost.push_back(cost);
+        periodMoves.push_back(moves);
+        std::cout << "\t Period " << p << ": cost " << cost << ", " << moves << " move(s), time " << periodTime.back() << std::endl;
+    }
+    values.end();
+    time = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+}
+
+/* Displays the obtained results. */
+void RollingHorizon::printResult()
+{
+    std::cout << "=> Printing schedule ..." << std::endl;
+    std::cout << "\t period ; cost ; moves ; status ; time" << std::endl;
+    double totalCost = 0.0;
+    int totalMoves = 0;
+    for (unsigned int p = 0; p < periodStatus.size(); p++){
+        std::cout << "\t " << p << " ; ";
+        if (p < schedule.size()){
+            std::cout << periodCost[p] << " ; " << periodMoves[p] << " ; ";
+            totalCost += periodCost[p];
+            totalMoves += periodMoves[p];
+        }
+        else{
+            std::cout << "- ; - ; ";
+        }
+        std::cout << periodStatus[p] << " ; " << periodTime[p] << std::endl;
+    }
+    std::cout << "Committed periods: " << schedule.size() << "/" << nbPeriods << std::endl;
+    std::cout << "Placement cost: " << totalCost << std::endl;
+    std::cout << "Moves: " << totalMoves << std::endl;
+    std::cout << "Total time: " << time << std::endl << std::endl;
+}
+
+/* Outputs the obtained results, and writes the committed placements to the schedule file. */
+void RollingHorizon::output()
+{
+    double totalCost = 0.0;
+    int totalMoves = 0;
+    for (unsigned int p = 0; p < schedule.size(); p++){
+        totalCost += periodCost[p];
+        totalMoves += periodMoves[p];
+    }
+
+    std::string output_file = data.getInput().getOutputFile();
+    if (!output_file.empty()){
+        std::ofstream fileReport(output_file, std::ios_base::app); // File report
+        // If file_output can't be opened
+        if(!fileReport)
+        {
+            std::cerr << "ERROR: Unable to access output file." << std::endl;
+            exit(EXIT_FAILURE);
+        }
+
+        std::string demand_name = getInBetweenString(data.getInput().getDemandFile(), "/", ".");
+        std::string node_name = getInBetweenString(data.getInput().getNodeFile(), "/", ".");
+        std::string instance_name = node_name + "_" + demand_name;
+
+        fileReport << instance_name << ";"
+                   << time << ";"
+                   << totalCost << ";"
+                   << totalMoves << ";"
+                   << schedule.size() << ";"
+                   << horizon << ";"
+                   << std::endl;
+        fileReport.close();
+    }
+
+    std::string schedule_file = data.getInput().getScheduleFile();
+    if (schedule_file.empty()){
+        return;
+    }
+    std::ofstream fileSchedule(schedule_file, std::ios_base::trunc);
+    if(!fileSchedule)
+    {
+        std::cerr << "ERROR: Unable to access schedule file." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    fileSchedule << "period;demand;du;cu;" << std::endl;
+    for (unsigned int p = 0; p < schedule.size(); p++){
+        for (int i = 0; i < data.getNbDemands(); i++){
+            const Candidate& candidate = data.getCandidates(i)[schedule[p][i]];
+            fileSchedule << p << ";" << data.getDemand(i).getName() << ";"
+                         << data.getNode(candidate.getDU()).getName() << ";" << data.getNode(candidate.getCU()).getName() << ";" << std::endl;
+        }
+    }
+    fileSchedule.close();
+    std::cout << "=> Schedule written to " << schedule_file << "." << std::endl;
+}
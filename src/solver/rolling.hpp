@@ -0,0 +1,95 @@
+#ifndef __rolling__hpp
+#define __rolling__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <chrono>
+
+/*** Own Libraries ***/
+#include "model.hpp"
+
+
+/********************************************************************************************
+ * This class plans the placement over a sequence of periods (e.g. the 24 hours of a day),
+ * each with its own throughput per demand. A window of H consecutive periods is solved at
+ * once, with a penalty each time a demand moves to another candidate between two periods,
+ * including between the placement already committed and the first period of the window.
+ * The first period of the window is then committed and the window slides by one period;
+ * periods wrap around, so the last windows see the beginning of the next day. The model is
+ * built once: sliding only rewrites the throughputs of the capacity rows and the bounds of
+ * the rows tying the window to the committed placement, and the previous solution shifted
+ * by one period is installed as a MIP start.
+********************************************************************************************/
+class RollingHorizon
+{
+	private:
+		const IloEnv&       				env;    		/**< IBM environment **/
+		const Data&     					data;   		/**< Data read in data.hpp **/
+		Conditioning 						conditioning;	/**< Units in which throughputs, capacities and costs are written. **/
+		int 								nbPeriods;		/**< Number of periods to be committed. **/
+		int 								horizon;		/**< Number of periods in a window. **/
+
+		IloModel    						model;			/**< IBM Model **/
+		IloCplex    						cplex;			/**< IBM Cplex **/
+		IloNumVarArray 						columns;		/**< Placement variables of every period of the window, period by period. **/
+		std::vector<int> 					columnStart;	/**< Position in a period block of the first column of each demand. **/
+		std::vector<IloNumVarMatrix> 		z;				/**< z[t][i][c] = 1 if demand i uses its c-th candidate in the t-th period of the window. **/
+		std::vector<IloNumVarVector> 		moved;			/**< moved[t][i] = 1 if demand i changes candidate at the t-th period of the window. **/
+		std::vector<int> 					capacityLinks;	/**< Links used by at least one candidate. **/
+		std::vector<std::vector<std::pair<int, int> > > users;	/**< Candidates (demand, candidate) consuming the capacity of each link of capacityLinks. **/
+		std::vector<std::vector<IloRange> > capacity;		/**< capacity[t][k]: capacity row of the k-th link of capacityLinks in the t-th period of the window. **/
+		std::vector<std::vector<IloRange> > firstMove;		/**< firstMove[i][c]: row detecting a move of demand i from the committed placement, for candidate c. **/
+
+		std::vector<std::vector<int> > 		schedule;		/**< Placement committed in each period. **/
+		std::vector<double> 				periodCost;		/**< Placement cost of each committed period. **/
+		std::vector<int> 					periodMoves;	/**< Number of demands moved when committing each period. **/
+		std::vector<double> 				periodTime;		/**< Time (in seconds) spent on the window of each period. **/
+		std::vector<IloAlgorithm::Status> 	periodStatus;	/**< Cplex status of the window of each period. **/
+		double 								time;			/**< Wall time (in seconds) spent on the whole horizon. **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. Builds the model of one window. **/
+		RollingHorizon(const IloEnv& env, const Data& data);
+		RollingHorizon(const IloEnv& env, const Data&&) = delete;
+		RollingHorizon() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns the placement committed in each period. **/
+		const std::vector<std::vector<int> >& getSchedule() const { return schedule; }
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Builds the variables, constraints and objective of one window. **/
+		void build();
+
+		/** Writes the throughputs of the window starting at the given period into the capacity rows. **/
+		void setWindow(const int first);
+
+		/** Ties the first period of the window to the given committed placement (no penalty if empty). **/
+		void setCommitted(const std::vector<int>& placement);
+
+		/** Installs the given placement of each period of the window as a MIP start. **/
+		void setMipStart(const std::vector<std::vector<int> >& placements);
+
+		/** Solves every window and commits their first period. **/
+		void run();
+
+		/** Displays the obtained results. **/
+		void printResult();
+
+		/** Outputs the obtained results, and writes the committed placements to the schedule file. **/
+		void output();
+};
+
+
+#endif
@@ -0,0 +1,104 @@
+#include "tuning.hpp"
+
+/****************************************************************************************/
+/*										Constructors									*/
+/****************************************************************************************/
+
+Tuning::Tuning(const Input& input_) : input(input_)
+{
+    std::string directory = input.getTuningDir();
+    if (directory.back() != '/'){
+        directory += "/";
+    }
+    std::cout << "=> Listing tuning instances in " << directory << " ..." << std::endl;
+    DIR* dir = opendir(directory.c_str());
+    if (dir == NULL){
+        std::cerr << "ERROR: Unable to open tuning directory '" << directory << "'." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != NULL){
+        std::string name = entry->d_name;
+        if (name == "." || name == ".."){
+            continue;
+        }
+        std::string instance = directory + name + "/";
+        std::ifstream node((instance + "node.csv").c_str()), link((instance + "link.csv").c_str()), demand((instance + "demand.csv").c_str());
+        if (node.is_open() && link.is_open() && demand.is_open()){
+            instances.push_back(instance);
+        }
+    }
+    closedir(dir);
+    std::sort(instances.begin(), instances.end());
+    std::cout << "\t " << instances.size() << " instance(s) found." << std::endl;
+    if (instances.empty()){
+        std::cerr << "ERROR: No instance (node.csv, link.csv and demand.csv) found in tuning directory '" << directory << "'." << std::endl;
+        exit(EXIT_FAILURE);
+    }
+}
+
+/****************************************************************************************/
+/*										   Methods  									*/
+/****************************************************************************************/
+
+/* Builds every instance, tunes the Cplex parameters over them and saves the tuned settings. */
+void Tuning::run()
+{
+    IloEnv env;
+    try
+    {
+        /* Each instance goes through the same reductions as a regular run. */
+        std::vector<std::unique_ptr<Data> > datas;
+        std::vector<std::unique_ptr<Model> > models;
+        IloArray<IloModel> tuningModels(env);
+        for (unsigned int k = 0; k < instances.size(); k++){
+            Input instanceInput = input;
+            instanceInput.setInstanceFiles(instances[k] + "node.csv", instances[k] + "link.csv", instances[k] + "demand.csv");
+            datas.push_back(std::unique_ptr<Data>(new Data(instanceInput)));
+            if (input.isPresolve()){
+                Presolve presolve(*datas.back());
+                presolve.run();
+                if (presolve.isInfeasible()){
+                    std::cout << "\t Instance " << instances[k] << " is infeasible and is left out." << std::endl;
+                    continue;
+                }
+            }
+            models.push_back(std::unique_ptr<Model>(new Model(env, *datas.back())));
+            tuningModels.add(models.back()->getModel());
+        }
+
+        /* The time limit of the parameter file bounds the whole tuning; each test run gets a share of it. */
+        IloCplex tuner(env);
+        if (!input.getCplexParamFile().empty()){
+            tuner.readParam(input.getCplexParamFile().c_str());
+        }
+        double runLimit = std::max(1.0, (double)input.getTimeLimit() / (TUNING_TRIALS_PER_INSTANCE * std::max(1, (int)models.size())));
+        tuner.setParam(IloCplex::Param::Tune::TimeLimit, input.getTimeLimit());
+        tuner.setParam(IloCplex::Param::TimeLimit, runLimit);
+        if (input.getNbThreads() > 0){
+            tuner.setParam(IloCplex::Param::Threads, input.getNbThreads());
+        }
+        std::cout << "=> Tuning Cplex parameters over " << models.size() << " instance(s), " << runLimit << " seconds per test run ..." << std::endl;
+        IloInt status = tuner.tuneParam(tuningModels);
+        if (status == IloCplex::TuningComplete){
+            std::cout << "\t Tuning completed." << std::endl;
+        }
+        else{
+            std::cout << "\t Tuning stopped before completion (status " << status << "), the best settings found so far are kept." << std::endl;
+        }
+
+        /* The limits used for tuning are not part of the tuned settings. */
+        tuner.setParam(IloCplex::Param::TimeLimit, TUNING_DEFAULT_TIME_LIMIT);
+        tuner.setParam(IloCplex::Param::Tune::TimeLimit, TUNING_DEFAULT_TIME_LIMIT);
+        tuner.setParam(IloCplex::Param::Threads, 0);
+        tuner.writeParam(input.getTuningFile().c_str());
+        std::cout << "=> Tuned settings saved to " << input.getTuningFile() << "." << std::endl;
+
+        tuner.end();
+        tuningModels.end();
+        models.clear();
+    }
+    catch (const IloException& e) { std::cerr << "Exception caught: " << e << std::endl; }
+    catch (...) { std::cerr << "Unknown exception caught!" << std::endl; }
+    env.end();
+}
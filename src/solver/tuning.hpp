@@ -0,0 +1,61 @@
+#ifndef __tuning__hpp
+#define __tuning__hpp
+
+
+/****************************************************************************************/
+/*										LIBRARIES										*/
+/****************************************************************************************/
+
+/*** C++ Libraries ***/
+#include <dirent.h>
+#include <memory>
+
+/*** Own Libraries ***/
+#include "model.hpp"
+#include "../instance/presolve.hpp"
+
+/****************************************************************************************/
+/*										CONSTANTS										*/
+/****************************************************************************************/
+#define TUNING_TRIALS_PER_INSTANCE 	10 		// Expected number of test runs per instance, used to split the time limit
+#define TUNING_DEFAULT_TIME_LIMIT 	1e+75 	// Cplex default time limit, restored before saving the tuned settings
+
+
+/********************************************************************************************
+ * This class tunes the Cplex parameters over a set of instances of the same family. Every
+ * subdirectory of the tuning directory holding a node.csv, a link.csv and a demand.csv file
+ * is one instance. Each instance goes through the usual pipeline (Data, presolve, Model)
+ * and all the models are handed to IloCplex::tuneParam, which tries settings within the
+ * time limit of the parameter file. The winning settings are saved as a .prm file, to be
+ * referenced by the field cplexParams of later runs.
+********************************************************************************************/
+class Tuning
+{
+	private:
+		const Input&     				input;   		/**< Parameters of the tuning run. **/
+		std::vector<std::string> 		instances;		/**< Directories of the instances to be tuned over. **/
+
+	public:
+	/****************************************************************************************/
+	/*										Constructors									*/
+	/****************************************************************************************/
+		/** Constructor. Lists the instances of the tuning directory. **/
+		Tuning(const Input& input);
+		Tuning(const Input&&) = delete;
+		Tuning() = delete;
+
+	/****************************************************************************************/
+	/*										Getters											*/
+	/****************************************************************************************/
+		/** Returns the directories of the instances to be tuned over. **/
+		const std::vector<std::string>& getInstances() const { return instances; }
+
+	/****************************************************************************************/
+	/*										   Methods  									*/
+	/****************************************************************************************/
+		/** Builds every instance, tunes the Cplex parameters over them and saves the tuned settings. **/
+		void run();
+};
+
+
+#endif
@@ -0,0 +1,57 @@
+#include "namepool.hpp"
+
+/* Returns the slot holding the given name, or the empty slot where it would be inserted. */
+size_t NamePool::locate(const std::string& name) const
+{
+	const size_t mask = slots.size() - 1;
+	size_t slot = std::hash<std::string>()(name) & mask;
+	while (slots[slot] >= 0 && names[slots[slot]] != name){
+		slot = (slot + 1) & mask;
+	}
+	return slot;
+}
+
+/* Doubles the hash table and reinserts every name. */
+void NamePool::grow()
+{
+	slots.assign(2 * slots.size(), -1);
+	for (unsigned int id = 0; id < names.size(); id++){
+		slots[locate(names[id])] = id;
+	}
+}
+
+/* Returns the position of the given name, inserting it if needed. */
+int NamePool::intern(const std::string& name)
+{
+	size_t slot = locate(name);
+	if (slots[slot] >= 0){
+		return slots[slot];
+	}
+	int id = names.size();
+	names.push_back(name);
+	slots[slot] = id;
+	/* The table is kept at most half full, so that probe sequences stay short. */
+	if (2 * names.size() > slots.size()){
+		grow();
+	}
+	return id;
+}
+
+/* Returns the position of the given name, or -1 if it is not in the pool. */
+int NamePool::find(const std::string& name) const
+{
+	return slots[locate(name)];
+}
+
+/* Returns the memory used by the pool. */
+size_t NamePool::getMemory() const
+{
+	size_t memory = names.capacity() * sizeof(std::string) + slots.capacity() * sizeof(int);
+	for (unsigned int id = 0; id < names.size(); id++){
+		/* Short names are stored inside the string object itself. */
+		if (names[id].capacity() > std::string().capacity()){
+			memory += names[id].capacity() + 1;
+		}
+	}
+	return memory;
+}
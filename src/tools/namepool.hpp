@@ -0,0 +1,47 @@
+#ifndef __namepool__hpp
+#define __namepool__hpp
+
+#include <string>
+#include <vector>
+#include <functional>
+
+/**
+ * This class implements a pool of interned names: each distinct name is stored once and
+ * identified by its position in the pool. Names are located through an open-addressing
+ * table holding positions only, so that no second copy of the strings is kept as keys.
+ */
+class NamePool{
+private:
+	std::vector<std::string> 	names;	/**< Distinct names, by order of insertion. **/
+	std::vector<int> 			slots;	/**< Hash table of positions in names (-1 if empty); its size is a power of 2. **/
+
+	/** Returns the slot holding the given name, or the empty slot where it would be inserted. **/
+	size_t locate(const std::string& name) const;
+
+	/** Doubles the hash table and reinserts every name. **/
+	void grow();
+
+public:
+	/** Constructor. **/
+	NamePool(): slots(16, -1){}
+
+	/** Returns the position of the given name, inserting it if needed. **/
+	int intern(const std::string& name);
+
+	/** Returns the position of the given name, or -1 if it is not in the pool. **/
+	int find(const std::string& name) const;
+
+	/** Returns the name at the given position. **/
+	const std::string& getName(const int id) const { return names[id]; }
+
+	/** Returns the number of distinct names. **/
+	int getSize() const { return (int)names.size(); }
+
+	/** Returns the memory (in bytes) used by the pool. **/
+	size_t getMemory() const;
+
+	/** Empties the pool. **/
+	void clear() { names.clear(); slots.assign(16, -1); }
+};
+
+#endif
@@ -46,4 +46,19 @@ void printVector(const std::vector<double> &v, std::string name){
         std::cout << k << " : " << v[k] << std::endl;
     }
     std::cout << std::endl;
-}
\ No newline at end of file
+}
+
+std::string formatNumber(const double value){
+    std::ostringstream stream;
+    stream << value;
+    return stream.str();
+}
+
+std::string insertSuffix(const std::string& filename, const std::string& suffix){
+    std::size_t slash = filename.find_last_of("/\\");
+    std::size_t dot = filename.find_last_of('.');
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash)){
+        return filename + suffix;
+    }
+    return filename.substr(0, dot) + suffix + filename.substr(dot);
+}
@@ -6,6 +6,7 @@
 #include <vector>
 #include <numeric>
 #include <algorithm>
+#include <sstream>
 
 /***************************************************
  *  This file hosts the list of auxiliary methods. 
@@ -26,4 +27,10 @@ std::vector<int> getSortedIndexes_Desc(const std::vector<double> &vec);
 /** Prints the vector name and its contents. @param vec The vector to be printed. @param name The vector's name **/
 void printVector(const std::vector<double> &v, std::string name);
 
+/** Returns a number written as std::cout would write it (e.g., 1e+10 rather than 10000000000.000000). @param value The number to be written. **/
+std::string formatNumber(const double value);
+
+/** Returns the file name with a suffix inserted before its extension. @param filename The file name. @param suffix The suffix to be inserted. @note Ex.: ("out/placement.csv", "_2") => "out/placement_2.csv" **/
+std::string insertSuffix(const std::string& filename, const std::string& suffix);
+
 #endif
\ No newline at end of file
@@ -3,24 +3,156 @@
 /* Function to fetch data from a CSV File. */
 std::vector<std::vector<std::string> > Reader::getData()
 {
-	std::ifstream file(filename.c_str());
+	std::ifstream file(filename.c_str(), std::ios_base::binary);
 	std::vector<std::vector<std::string> > dataList;
-	if (file.is_open()) {
-		std::string line = "";
-		// Iterate through each line and split the content using delimeter
-		while (getline(file, line)){
-			std::vector<std::string> splittedVector = split(line, getDelimeter());
-			dataList.push_back(splittedVector);
-		}
-		file.close();
-	}
-	else {
+	if (!file.is_open()) {
 		std::cerr << "ERROR: Unable to open file " << filename << "." << std::endl;
 		exit(EXIT_FAILURE);
 	}
+	/* The format is given by the first bytes of the file; the extension only has to agree with them. */
+	unsigned char magic[4] = {0, 0, 0, 0};
+	file.read((char*)magic, 4);
+	file.clear();
+	file.seekg(0);
+	bool gzip = (magic[0] == 0x1f && magic[1] == 0x8b);
+	bool zstd = (magic[0] == 0x28 && magic[1] == 0xb5 && magic[2] == 0x2f && magic[3] == 0xfd);
+	bool gzExtension = (filename.size() > 3 && filename.compare(filename.size() - 3, 3, ".gz") == 0);
+	bool zstExtension = (filename.size() > 4 && filename.compare(filename.size() - 4, 4, ".zst") == 0);
+	if ((gzExtension && !gzip) || (zstExtension && !zstd)){
+		std::cerr << "ERROR: File " << filename << " does not hold the compressed data its extension announces." << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	if (gzip){
+		readGzip(file, dataList);
+	}
+	else if (zstd){
+		readZstd(file, dataList);
+	}
+	else {
+		readPlain(file, dataList);
+	}
+	file.close();
 	return dataList;
 }
 
+/* Splits the complete lines of a block into the data list; the last, unfinished line is kept in pending. */
+void Reader::parseBlock(const char* block, const size_t size, std::string& pending, std::vector<std::vector<std::string> >& dataList) const
+{
+	const char* end = block + size;
+	while (block < end){
+		const char* newline = (const char*)memchr(block, '\n', end - block);
+		if (newline == NULL){
+			pending.append(block, end);
+			return;
+		}
+		pending.append(block, newline);
+		dataList.push_back(split(pending, getDelimeter()));
+		pending.clear();
+		block = newline + 1;
+	}
+}
+
+/* Reads a plain file block by block. */
+void Reader::readPlain(std::ifstream& file, std::vector<std::vector<std::string> >& dataList) const
+{
+	std::vector<char> block(READ_BLOCK_SIZE);
+	std::string pending = "";
+	while (file){
+		file.read(block.data(), block.size());
+		parseBlock(block.data(), file.gcount(), pending, dataList);
+	}
+	if (!pending.empty()){
+		dataList.push_back(split(pending, getDelimeter()));
+	}
+}
+
+/* Decompresses a gzip file block by block. */
+void Reader::readGzip(std::ifstream& file, std::vector<std::vector<std::string> >& dataList) const
+{
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+	/* 15 + 32: largest window, and zlib detects the gzip header by itself. */
+	if (inflateInit2(&stream, 15 + 32) != Z_OK){
+		std::cerr << "ERROR: Unable to start decompressing file " << filename << "." << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	std::vector<char> input(READ_BLOCK_SIZE), output(READ_BLOCK_SIZE);
+	std::string pending = "";
+	int status = Z_OK;
+	while (file){
+		file.read(input.data(), input.size());
+		stream.next_in = (Bytef*)input.data();
+		stream.avail_in = file.gcount();
+		if (stream.avail_in == 0){
+			break;
+		}
+		do {
+			/* A gzip file may hold several members one after the other. */
+			if (status == Z_STREAM_END){
+				if (stream.avail_in == 0){
+					break;
+				}
+				inflateReset(&stream);
+			}
+			stream.next_out = (Bytef*)output.data();
+			stream.avail_out = output.size();
+			status = inflate(&stream, Z_NO_FLUSH);
+			if (status == Z_NEED_DICT || status == Z_DATA_ERROR || status == Z_MEM_ERROR || status == Z_STREAM_ERROR){
+				std::cerr << "ERROR: File " << filename << " is not a valid gzip file (" << (stream.msg ? stream.msg : "corrupted data") << ")." << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			parseBlock(output.data(), output.size() - stream.avail_out, pending, dataList);
+		} while (stream.avail_in > 0 || stream.avail_out == 0);
+	}
+	inflateEnd(&stream);
+	if (status != Z_STREAM_END){
+		std::cerr << "ERROR: File " << filename << " ends before the end of its gzip data." << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	if (!pending.empty()){
+		dataList.push_back(split(pending, getDelimeter()));
+	}
+}
+
+/* Decompresses a zstd file block by block. */
+void Reader::readZstd(std::ifstream& file, std::vector<std::vector<std::string> >& dataList) const
+{
+#ifdef USE_ZSTD
+	ZSTD_DStream* stream = ZSTD_createDStream();
+	ZSTD_initDStream(stream);
+	std::vector<char> input(READ_BLOCK_SIZE), output(READ_BLOCK_SIZE);
+	std::string pending = "";
+	size_t remaining = 0;
+	while (file){
+		file.read(input.data(), input.size());
+		ZSTD_inBuffer in = { input.data(), (size_t)file.gcount(), 0 };
+		ZSTD_outBuffer out = { output.data(), output.size(), 0 };
+		while (in.pos < in.size || out.pos == out.size){
+			out.pos = 0;
+			remaining = ZSTD_decompressStream(stream, &out, &in);
+			if (ZSTD_isError(remaining)){
+				std::cerr << "ERROR: File " << filename << " is not a valid zstd file (" << ZSTD_getErrorName(remaining) << ")." << std::endl;
+				exit(EXIT_FAILURE);
+			}
+			parseBlock(output.data(), out.pos, pending, dataList);
+		}
+	}
+	ZSTD_freeDStream(stream);
+	if (remaining != 0){
+		std::cerr << "ERROR: File " << filename << " ends before the end of its zstd data." << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	if (!pending.empty()){
+		dataList.push_back(split(pending, getDelimeter()));
+	}
+#else
+	(void)file;
+	(void)dataList;
+	std::cerr << "ERROR: File " << filename << " is compressed with zstd, which this build cannot read. Please compile with ZSTD=1." << std::endl;
+	exit(EXIT_FAILURE);
+#endif
+}
+
 /* Returns the substring of str between the first and last delimiters */
 std::string getInBetweenString(std::string str, std::string firstDelimiter, std::string lastDelimiter)
 {
@@ -6,15 +6,39 @@
 #include <vector>
 #include <string>
 #include <algorithm>
+#include <cstring>
+
+/*** Decompression Libraries ***/
+#include <zlib.h>
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
+#define READ_BLOCK_SIZE 65536 	// Bytes read from the file (and decompressed) at a time
 
 /**
  * This class implements a reader of .csv files. 
- * It is used for reading the input files.
+ * It is used for reading the input files. Files compressed with gzip (.csv.gz) or zstd
+ * (.csv.zst) are recognized by their first bytes and decompressed block by block while
+ * being parsed, so that the decompressed file is never held in memory or written to disk.
  */
 class Reader{
 private:
 	const std::string filename; 	/**< The file to be read. **/
 	const std::string delimeter;	/**< The delimiter used for separating data. **/
+
+	/** Splits the complete lines of a block into the data list; the last, unfinished line is kept in pending. **/
+	void parseBlock(const char* block, const size_t size, std::string& pending, std::vector<std::vector<std::string> >& dataList) const;
+
+	/** Reads a plain file block by block. **/
+	void readPlain(std::ifstream& file, std::vector<std::vector<std::string> >& dataList) const;
+
+	/** Decompresses a gzip file block by block. **/
+	void readGzip(std::ifstream& file, std::vector<std::vector<std::string> >& dataList) const;
+
+	/** Decompresses a zstd file block by block. **/
+	void readZstd(std::ifstream& file, std::vector<std::vector<std::string> >& dataList) const;
+
 public:
 	/** Constructor. @param filepath The path of the file to be read. @param delm The delimiter to be used. **/
 	Reader(std::string filepath, std::string delm = ";"): filename(filepath), delimeter(delm){}